@@ -0,0 +1,27 @@
+cmake_minimum_required(VERSION 3.12)
+
+## Fails if the firmware image links operator new or new[] (any variant, the
+## mangled names start with _Znw and _Zna): the firmware allocates all
+## objects statically.
+
+## Expect the following variables to have a value.
+foreach(v NM ELF)
+    if("${${v}}" STREQUAL "")
+        message(FATAL_ERROR "Required variable ${v} is empty")
+    endif()
+endforeach()
+
+execute_process(
+    COMMAND ${NM} --defined-only "${ELF}"
+    OUTPUT_VARIABLE SYMBOLS
+    RESULT_VARIABLE RESULT
+)
+if(NOT RESULT EQUAL 0)
+    message(FATAL_ERROR "Could not list the symbols of ${ELF}")
+endif()
+
+string(REGEX MATCHALL "[^\n]* _Zn[wa][^\n]*" ALLOCATORS "${SYMBOLS}")
+if(ALLOCATORS)
+    string(REPLACE ";" "\n" ALLOCATORS "${ALLOCATORS}")
+    message(FATAL_ERROR "Dynamic allocation linked into ${ELF}:\n${ALLOCATORS}")
+endif()
@@ -13,16 +13,56 @@
 //     CHN_Param   _chn_param;
 // void actuators_run();
 
-Actuator::Actuator(ControlLoop& ctrl, CHN_Param& chn_param) : _ctrl(ctrl), _chn_param(chn_param){};
+Actuator::Actuator(LDEngine& engine, CHN_Param& chn_param) : _engine(engine), _chn_param(chn_param){};
+/**
+ * @brief Fast rate group, in the control interrupt: fast path of all LD
+ * channels, transmits the fast output of channel 1.
+ */
 void Actuator::execute()
 {
-    float      sctrl_out;
-    float      fctrl_out;
-    const auto adc_values = read_LD_signals();
-    auto       pd_signal  = adc_values[0] * DIG2VOLT16BIT;
-    _ctrl.step(pd_signal, sctrl_out, fctrl_out); // actor_CH1
-    uint16_t dacout[2] = {fctrl_out * VOLT2DIG16BIT, sctrl_out * VOLT2DIG16BIT};
-    transmit_DAC_values(dacout, _chn_param); // CHN1_param
+    _fastParam.Receive([this](const LDEngine::param_t& param) { _engine.ApplyFast(param); });
+    std::array<float, LDCHNs> pd_signal;
+    std::array<float, LDCHNs> fctrl_out;
+    const auto                adc_values = read_LD_signals();
+    for (std::size_t chn = 0; chn < LDCHNs; chn++) {
+        pd_signal[chn] = adc_values[chn] * DIG2VOLT16BIT;
+    }
+    _engine.stepFast(pd_signal, fctrl_out); // all LD channels
+    transmit_fast_DAC_value((uint16_t)(fctrl_out[0] * VOLT2DIG16BIT), _chn_param); // CHN1_param
+}
+/**
+ * @brief Slow rate group, in the control interrupt: hands the decimated
+ * sample over to the slow-loop interrupt.
+ */
+void Actuator::deferSlow()
+{
+    LDEngine::channels_t slowSig;
+    if (_engine.TakeSlowSignal(slowSig)) {
+        _slow.Post(slowSig);
+    }
+}
+/**
+ * @brief Slow-loop interrupt: slow PIDs of all LD channels on the latest
+ * decimated sample, transmits the slow output of channel 1.
+ */
+void Actuator::executeSlow()
+{
+    _slowParam.Receive([this](const LDEngine::param_t& param) { _engine.ApplySlow(param); });
+    _slow.Run([this](const LDEngine::channels_t& slowSig) {
+        LDEngine::channels_t sctrl_out;
+        _engine.runSlow(slowSig, sctrl_out); // all LD channels
+        transmit_slow_DAC_value((uint16_t)(sctrl_out[0] * VOLT2DIG16BIT), _chn_param);
+    });
+}
+/**
+ * @brief Main context: sends a new parameter set of all LD channels.  The
+ * control interrupt applies its part at the start of its next tick, the
+ * slow-loop interrupt its part at its next run.
+ */
+void Actuator::SetParam(const LDEngine::param_t& param)
+{
+    _fastParam.Send(param);
+    _slowParam.Send(param);
 }
 // void actuators_run()
 // {
@@ -1,4 +1,8 @@
+#include "channelEngine.hpp"
 #include "ctrlLoop.hpp"
+#include "deferred.hpp"
+#include "mailbox.hpp"
+#include "peripherals.hpp"
 namespace {
 float    DIG2VOLT16BIT  = 3.7e-05;    // 2.45[v]/65535 ->16bit
 float    VOLT2DIG16BIT  = 2.6214e+04; // 2.5[v]/2^16->16bit
@@ -12,19 +16,29 @@ float    DDSamp         = 1.0f;
 float    DDSAmpOffset   = DDSamp;
 float    DDSfreq        = 20000.0f;
 float    DDSphaseOffset = 0.0f;
-float    FIRFreq        = 2000.0f;
+float    FIRFreq        = 2000.0f; // first zero of the boxcar, corner of an IIR filter
 int      AW             = 16;
-int      LUTL           = 10;
-SinusLUT LUT;
+int      LUTL           = SinusLUT<>::bits;
 } // namespace
+// engine of all LD channels, its lock-in filter BoxcarFilter<LDCHNs> or IirFilter<LDCHNs, Order>
+using LDEngine = ChannelEngine<LDCHNs, BoxcarFilter<LDCHNs>>;
 class Actuator
 {
   public:
-    Actuator(ControlLoop& ctrl, CHN_Param& chn_param);
+    Actuator(LDEngine& engine, CHN_Param& chn_param);
     void execute();
+    void deferSlow();
+    void executeSlow();
+    void SetParam(const LDEngine::param_t& param);
 
   private:
-    ControlLoop _ctrl;
-    CHN_Param   _chn_param;
+    using slow_t    = Deferred<LDEngine::channels_t, SlowLoopTrigger>;
+    using mailbox_t = Mailbox<LDEngine::param_t>;
+
+    LDEngine& _engine;
+    CHN_Param _chn_param; // DAC outputs of channel 1, the other channels have no DACs yet
+    slow_t    _slow;      // decimated samples, control interrupt to slow-loop interrupt
+    mailbox_t _fastParam; // parameter sets, main context to control interrupt
+    mailbox_t _slowParam; // parameter sets, main context to slow-loop interrupt
 };
 void actuators_run();
@@ -8,11 +8,13 @@
 
 #include "application.h"
 #include "actors.h"
+#include "channelEngine.hpp"
 #include "ctrlLoop.hpp"
 #include "dds.hpp"
 #include "hard_fault_handler.h"
 #include "lockIn.hpp"
 #include "peripherals.hpp"
+#include "rateScheduler.hpp"
 #include "sinusLUT.hpp"
 #include "version.h"
 #include <stm32h7xx.h>
@@ -24,12 +26,46 @@
 // LockIn*         lock_in   = new LockIn(dds_param, FIRFreq);
 // ControlLoop*    ctrl      = new ControlLoop(pid_param, dds_param, FIRFreq);
 // } // namespace
-struct PIDParam pid_param_CHN1 = {kp_f, ki_f, kd_f, kp_s, ki_s, kd_s};
-struct DDSParam dds_param      = {true, DDSamp, DDSAmpOffset, DDSfreq, DDSphaseOffset, MainFreq, AW, LUTL, LUT};
-ControlLoop     actor_CH1      = ControlLoop(pid_param_CHN1, dds_param, FIRFreq);
-CHN_Param       CHN1_param     = {DAC_CHN1_FAST, DAC_SLOW_CHN1};
-Actuator        act_chn1       = Actuator(actor_CH1, CHN1_param);
-void            ctrl_test()
+struct PIDParam       pid_param_CHN1 = {kp_f, ki_f, kd_f, kp_s, ki_s, kd_s};
+struct DDSParam       dds_param      = {true, DDSamp, DDSAmpOffset, DDSfreq, DDSphaseOffset, MainFreq, AW, LUTL, sinusLUT};
+LDEngine              engine         = LDEngine(pid_param_CHN1, dds_param, FIRFreq); // all LD channels alike
+CHN_Param             CHN1_param     = {DAC_CHN1_FAST, DAC_SLOW_CHN1};
+Actuator              act_chn1       = Actuator(engine, CHN1_param);
+
+/**
+ * @brief Free-running cycle counter of the core, times the scheduled tasks.
+ */
+struct DwtCycleCounter
+{
+    static void Enable()
+    {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->LAR    = 0xC5ACCE55; // unlock
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    static uint32_t Now()
+    {
+        return DWT->CYCCNT;
+    }
+};
+
+// Rate groups of the TIM2 tick (CtrlFreq), budgets of the 2000 cycles per
+// tick: the fast path every tick, the handoff to the slow loop once per
+// CountLim ticks on the tick the CIC decimators complete their sample.  The
+// slow PIDs themselves run in the slow-loop interrupt, outside the budget of
+// the tick.  Further slow tasks take other phases, they must not meet the
+// handoff on one tick.
+constexpr std::array<RateGroup, 2> RATE_GROUPS{{
+    {1, 0, 1500},                                     // fast path
+    {(uint32_t)CountLim, (uint32_t)CountLim - 1, 100}, // slow-loop handoff
+}};
+static_assert(RateGroupsValid(RATE_GROUPS), "Slow tasks share a tick!");
+
+auto scheduler = MakeRateScheduler<DwtCycleCounter>(
+    RATE_GROUPS, [] { act_chn1.execute(); }, [] { act_chn1.deferSlow(); });
+
+void ctrl_test()
 {
     int count = 0;
     HAL_GPIO_TogglePin(DEBUGGING_PORT, DEBUGGING_PIN);
@@ -37,7 +73,7 @@ void            ctrl_test()
         count++;
     }
     // actuators_run();
-    act_chn1.execute();
+    scheduler.Tick();
 }
 // void Lock_In_test()
 // {
@@ -83,8 +119,11 @@ void application()
     HAL_DBGMCU_EnableDBGSleepMode();
     HAL_DBGMCU_EnableDBGStopMode();
     enable_extra_usage_faults();
+    DwtCycleCounter::Enable();
     peripheral_initialization();
     while (true) {
+        // parameter changes of the running loop go through
+        // act_chn1.SetParam(), never to the engine directly
     }
 }
 
@@ -97,3 +136,10 @@ void application_interupt()
     // Lock_In_test();
     ctrl_test();
 }
+
+void application_slow_interupt()
+{
+    // slow loop of all channels; housekeeping that must not delay the
+    // control interrupt goes here as well
+    act_chn1.executeSlow();
+}
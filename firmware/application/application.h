@@ -18,6 +18,11 @@ extern "C" {
  */
 void application();
 void application_interupt();
+/**
+ * @brief Slow-loop interrupt, PendSV: work deferred from
+ * `application_interupt()`, preempted by it.
+ */
+void application_slow_interupt();
 void control_test();
 
 #ifdef __cplusplus
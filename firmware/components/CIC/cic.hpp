@@ -0,0 +1,222 @@
+#pragma once
+#include "fir.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace cic_detail {
+struct no_compensation
+{
+};
+} // namespace cic_detail
+
+/**
+ * @brief Cascaded integrator-comb (CIC) decimator.
+ *
+ * @p Order integrators run at the input rate, @p Order combs with
+ * differential delay @p DifferentialDelay at the output rate, so the filter
+ * needs only additions: per input sample @p Order 64 bit additions, per
+ * output sample @p Order subtractions.  The input is quantized to 32 bit of
+ * the given full scale; the integrators wrap in two's complement, which
+ * cancels in the combs as long as the bit growth `Order * log2(ratio *
+ * DifferentialDelay)` fits the remaining 32 bit (see @ref MaxRatio).  The
+ * output is normalized to unit DC gain.
+ *
+ * The optional compensation FIR at the output rate flattens the sinc^Order
+ * droop of the passband, at the cost of (CompensationTaps - 1) / 2 output
+ * samples delay.
+ *
+ * @tparam Order             Number of integrator and comb stages.
+ * @tparam DifferentialDelay Comb delay in output samples, 1 or 2.
+ * @tparam CompensationTaps  Length of the compensation FIR, odd, 0 for none.
+ */
+template <int Order, int DifferentialDelay = 1, std::size_t CompensationTaps = 0>
+class Cic
+{
+    static_assert(Order >= 1 && Order <= 6, "CIC order must be 1..6!");
+    static_assert(DifferentialDelay == 1 || DifferentialDelay == 2, "Differential delay must be 1 or 2!");
+    static_assert(CompensationTaps == 0 || CompensationTaps % 2 == 1, "Compensation FIR must have odd length!");
+
+  public:
+    using compensation_t = std::array<float, (CompensationTaps > 0) ? CompensationTaps : 1>;
+
+    /**
+     * @param ratio     Decimation ratio, limited to @ref MaxRatio.
+     * @param fullScale Largest input magnitude, larger inputs saturate.
+     * @param cutoff    Passband edge of the compensation FIR relative to
+     *                  the output rate (0..0.5).
+     */
+    Cic(uint32_t ratio, float fullScale, float cutoff = 0.25f)
+    {
+        _ratio       = std::max(1u, std::min(ratio, MaxRatio()));
+        _inputScale  = (float)(2147483647.0 / (double)fullScale);
+        _outputScale = (float)((double)fullScale / 2147483647.0
+                               / std::pow((double)_ratio * DifferentialDelay, (double)Order));
+        if constexpr (CompensationTaps > 0) {
+            _compensation.SetCoefficients(Compensation(_ratio, cutoff));
+        }
+    }
+
+    /**
+     * @brief Largest decimation ratio without overflow of the output.
+     */
+    static constexpr uint32_t MaxRatio()
+    {
+        // (ratio * DifferentialDelay)^Order <= 2^32, by bisection
+        uint32_t low  = 1;
+        uint32_t high = (uint32_t)(0xffffffffu / DifferentialDelay);
+        while (low < high) {
+            const uint32_t mid = low + (high - low + 1) / 2;
+            if (m_growth((uint64_t)mid * DifferentialDelay) <= (1ull << 32)) {
+                low = mid;
+            } else {
+                high = mid - 1;
+            }
+        }
+        return low;
+    }
+
+    uint32_t Ratio() const
+    {
+        return _ratio;
+    }
+
+    /**
+     * @brief Feeds one input sample.
+     *
+     * @return true if the sample completed an output sample in @p output.
+     */
+    bool Calc(float input, float& output)
+    {
+        const float scaled = std::max(-2147483520.0f, std::min(input * _inputScale, 2147483520.0f));
+        uint64_t    x      = (uint64_t)(int64_t)(int32_t)scaled;
+        for (auto& integrator : _integrator) {
+            integrator += x;
+            x = integrator;
+        }
+
+        if (++_count < _ratio) {
+            return false;
+        }
+        _count = 0;
+
+        for (auto& comb : _comb) {
+            const uint64_t delayed = comb[_combIndex];
+            comb[_combIndex]       = x;
+            x -= delayed;
+        }
+        _combIndex = (_combIndex + 1 < DifferentialDelay) ? _combIndex + 1 : 0;
+
+        output = (float)(int64_t)x * _outputScale;
+        if constexpr (CompensationTaps > 0) {
+            output = _compensation.Calc(output);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Designs the compensation FIR.
+     *
+     * Weighted least-squares fit of a linear phase FIR to the inverse CIC
+     * response up to @p cutoff (relative to the output rate), with a small
+     * weight towards zero above, normalized to unit DC gain.  Runs in the
+     * thread context (double math).
+     */
+    static compensation_t Compensation(uint32_t ratio, float cutoff)
+    {
+        constexpr int half  = (int)(CompensationTaps / 2);
+        constexpr int n     = half + 1;
+        const int     steps = 512;
+        const double  pi    = 3.14159265358979323846;
+
+        // normal equations of A(f) = a_0 + 2 sum_j a_j cos(2 pi f j)
+        double g[n][n + 1]{};
+        for (int s = 0; s < steps; s++) {
+            const double f        = (s + 0.5) * 0.5 / steps;
+            const bool   passband = f <= (double)cutoff;
+            const double weight   = passband ? 1.0 : 0.0001;
+            double       target   = 0.0;
+            if (passband) {
+                const double cic = std::sin(pi * f * DifferentialDelay)
+                                   / ((double)ratio * DifferentialDelay * std::sin(pi * f / (double)ratio));
+                target = 1.0 / std::pow(cic, (double)Order);
+            }
+            double basis[n];
+            for (int j = 0; j < n; j++) {
+                basis[j] = (j == 0) ? 1.0 : 2.0 * std::cos(2.0 * pi * f * j);
+            }
+            for (int i = 0; i < n; i++) {
+                for (int j = 0; j < n; j++) {
+                    g[i][j] += weight * basis[i] * basis[j];
+                }
+                g[i][n] += weight * basis[i] * target;
+            }
+        }
+
+        // Gauss-Jordan elimination with partial pivoting
+        for (int c = 0; c < n; c++) {
+            int pivot = c;
+            for (int r = c + 1; r < n; r++) {
+                if (std::fabs(g[r][c]) > std::fabs(g[pivot][c])) {
+                    pivot = r;
+                }
+            }
+            for (int k = 0; k <= n; k++) {
+                std::swap(g[c][k], g[pivot][k]);
+            }
+            for (int r = 0; r < n; r++) {
+                if (r != c) {
+                    const double factor = g[r][c] / g[c][c];
+                    for (int k = c; k <= n; k++) {
+                        g[r][k] -= factor * g[c][k];
+                    }
+                }
+            }
+        }
+
+        double a[n];
+        double sum = 0.0;
+        for (int j = 0; j < n; j++) {
+            a[j] = g[j][n] / g[j][j];
+            sum += (j == 0) ? a[j] : 2.0 * a[j];
+        }
+
+        compensation_t h{};
+        for (int j = 0; j < n; j++) {
+            h[(std::size_t)(half + j)] = (float)(a[j] / sum);
+            h[(std::size_t)(half - j)] = (float)(a[j] / sum);
+        }
+        return h;
+    }
+
+  private:
+    // base^Order, saturated above 2^32
+    static constexpr uint64_t m_growth(uint64_t base)
+    {
+        uint64_t growth = 1;
+        for (int i = 0; i < Order; i++) {
+            if (growth > (1ull << 32) / base) {
+                return (1ull << 32) + 1;
+            }
+            growth *= base;
+        }
+        return growth;
+    }
+
+    using compensation_fir_t = std::conditional_t<(CompensationTaps > 0),
+                                                  Fir<float, (CompensationTaps > 0) ? CompensationTaps : 1>,
+                                                  cic_detail::no_compensation>;
+
+    // two's complement arithmetic in unsigned integers, wrapping is defined
+    std::array<uint64_t, Order>                                _integrator{};
+    std::array<std::array<uint64_t, DifferentialDelay>, Order> _comb{};
+    int                                                        _combIndex   = 0;
+    uint32_t                                                   _ratio       = 1;
+    uint32_t                                                   _count       = 0;
+    float                                                      _inputScale  = 1.0f;
+    float                                                      _outputScale = 1.0f;
+    compensation_fir_t                                         _compensation{};
+};
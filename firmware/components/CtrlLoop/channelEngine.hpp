@@ -0,0 +1,255 @@
+#pragma once
+#include "ctrlLoop.hpp"
+#include "dds.hpp"
+#include "ddsBank.hpp"
+#include "fir.hpp"
+#include "lockIn.hpp"
+#include "peripherals.hpp"
+#include <tsp/pid.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Runtime parameter set of a @ref ChannelEngine, all plain values so
+ * it can be sent as a whole through a parameter mailbox.  The references
+ * and the filter are in the words they are applied with, computed in the
+ * thread context by @ref ChannelEngine::Param.
+ */
+template <std::size_t Channels, class Filter>
+struct EngineParam
+{
+    std::array<PIDParam, Channels> pid;
+    std::array<DDSTone, Channels>  tone;
+    typename Filter::setting_t     filter; // common to all channels
+};
+
+/**
+ * @brief Lock-in and control loops of @p Channels laser channels, computed
+ * together per tick.
+ *
+ * Per channel the signal path of a lock-in based control loop: DDS
+ * reference, demodulation, low-pass filter and fast PID every sample,
+ * decimation and slow PID every `CountLim` samples.  The stages are composed
+ * at compile time and held by value, so the engine lives in one contiguous
+ * object without heap or pointer indirection and @ref step inlines.  Each
+ * stage runs all channels, the defaults in struct-of-arrays layout
+ * (@ref DDSBank, @ref BoxcarFilter, `tsp::pid::pid_bank`), so each stage is
+ * one loop over the channels on contiguous arrays instead of @p Channels
+ * separate objects.  The stages are constructed from
+ *
+ *   Reference(const SinusLUT<>&)            void Calc(channels_t& out), SetTone(channel, const DDSParam&),
+ *                                           static DDSTone Tone(const DDSParam&), Retune(channel, const DDSTone&)
+ *   Demodulator(uint32_t ratio)             void Calc(const channels_t& in, const channels_t& reference,
+ *                                           channels_t& out), bool TakeDecimated(channels_t& out)
+ *   Filter(float FIRfreq)                   void Calc(const channels_t& in, channels_t& out),
+ *                                           static setting_t Setting(float FIRfreq), void Apply(const setting_t&)
+ *   FastPid(float Ts), SlowPid(float Ts)    tsp::pid::pid_bank interface: set_p/i/d, enable, run
+ *
+ * e.g. @ref BoxcarFilter (first zero at `FIRfreq`) or @ref IirFilter (corner
+ * at `FIRfreq`) as filter, or a `pid_bank` with anti-windup as PIDs.
+ * `Setting` and `Tone` compute the parameter set in the thread context,
+ * `Apply` and `Retune` store it at bounded cost in the context of the loop.
+ *
+ * @tparam Channels    Number of channels.
+ * @tparam Filter      Low-pass filter stage of the fast path.
+ * @tparam Reference   DDS references of the channels.
+ * @tparam Demodulator Mixer and decimator of the slow path.
+ * @tparam FastPid     PIDs of the fast path.
+ * @tparam SlowPid     PIDs of the slow path.
+ */
+template <std::size_t Channels = LDCHNs,
+          class Filter         = BoxcarFilter<Channels>,
+          class Reference      = DDSBank<Channels>,
+          class Demodulator    = CicDemodulator<Channels>,
+          class FastPid        = toptica::tsp::pid::pid_bank<float, Channels>,
+          class SlowPid        = FastPid>
+class ChannelEngine
+{
+    static_assert(Channels > 0, "Channel engine needs at least one channel!");
+
+  public:
+    using channels_t = std::array<float, Channels>;
+    using param_t    = EngineParam<Channels, Filter>;
+
+    /**
+     * @brief Configures all channels alike, see @ref SetChannel.
+     */
+    ChannelEngine(const PIDParam& pid_param, const DDSParam& dds_param, const float FIRfreq)
+      : _dds(dds_param.LUT),
+        _demodulator((uint32_t)CountLim),
+        _filter(FIRfreq),
+        _pidf(TS),
+        _pids(CountLim * TS)
+    {
+        for (std::size_t channel = 0; channel < Channels; channel++) {
+            SetChannel(channel, pid_param, dds_param);
+            _pidf.enable(channel);
+            _pids.enable(channel);
+        }
+    }
+
+    /**
+     * @brief Sets PID coefficients and DDS reference of one channel.  The
+     * DDS parameters must use the same sine table as on construction.
+     */
+    void SetChannel(std::size_t channel, const PIDParam& pid_param, const DDSParam& dds_param)
+    {
+        _dds.SetTone(channel, dds_param);
+        m_set(_pidf, channel, pid_param.kpf, pid_param.kif, pid_param.kdf);
+        m_set(_pids, channel, pid_param.kps, pid_param.kis, pid_param.kds);
+    }
+
+    /**
+     * @brief Fast PIDs, e.g. for output limits or to hold a loop, in the
+     * context of @ref stepFast.
+     */
+    FastPid& FastPids()
+    {
+        return _pidf;
+    }
+
+    /**
+     * @brief Slow PIDs, as @ref FastPids in the context of @ref runSlow.
+     */
+    SlowPid& SlowPids()
+    {
+        return _pids;
+    }
+
+    /**
+     * @brief Parameter set of all channels alike, as on construction.
+     *
+     * Computes the phase words of the references and the filter setting,
+     * with double precision math: call it in the thread context.  Single
+     * channels are retuned with e.g. @ref DDSBank::Tone.
+     */
+    static param_t Param(const PIDParam& pid_param, const DDSParam& dds_param, const float FIRfreq)
+    {
+        param_t param;
+        param.pid.fill(pid_param);
+        param.tone.fill(Reference::Tone(dds_param));
+        param.filter = Filter::Setting(FIRfreq);
+        return param;
+    }
+
+    /**
+     * @brief Applies the part of @p param used by @ref stepFast: DDS
+     * references, fast PIDs and filter, in the context of @ref stepFast
+     * between two ticks.
+     *
+     * The references keep their phase and the PID integrators their state.
+     * Only stores the precomputed words, at constant cost: a new boxcar
+     * length clears the averages, but not the delay line.
+     */
+    void ApplyFast(const param_t& param)
+    {
+        for (std::size_t channel = 0; channel < Channels; channel++) {
+            _dds.Retune(channel, param.tone[channel]);
+            const PIDParam& pid = param.pid[channel];
+            m_set(_pidf, channel, pid.kpf, pid.kif, pid.kdf);
+        }
+        _filter.Apply(param.filter);
+    }
+
+    /**
+     * @brief Applies the slow PID part of @p param, in the context of
+     * @ref runSlow.
+     */
+    void ApplySlow(const param_t& param)
+    {
+        for (std::size_t channel = 0; channel < Channels; channel++) {
+            const PIDParam& pid = param.pid[channel];
+            m_set(_pids, channel, pid.kps, pid.kis, pid.kds);
+        }
+    }
+
+    /**
+     * @brief One control tick of all channels, @ref stepFast followed by
+     * @ref stepSlow.
+     *
+     * @param error     Photodiode signal per channel.
+     * @param sctrl_out Slow control output per channel, updated every
+     *                  `CountLim` ticks and held in between.
+     * @param fctrl_out Fast control output per channel.
+     */
+    void step(const channels_t& error, channels_t& sctrl_out, channels_t& fctrl_out)
+    {
+        stepFast(error, fctrl_out);
+        stepSlow(sctrl_out);
+    }
+
+    /**
+     * @brief Fast path of one control tick: demodulation with decimation,
+     * whose decimated samples are kept for @ref stepSlow, low-pass and fast
+     * PIDs.
+     */
+    void stepFast(const channels_t& error, channels_t& fctrl_out)
+    {
+        channels_t reference;
+        _dds.Calc(reference);
+
+        channels_t demodulated;
+        _demodulator.Calc(error, reference, demodulated);
+
+        channels_t lockinSig;
+        _filter.Calc(demodulated, lockinSig);
+        _pidf.run(lockinSig, fctrl_out);
+    }
+
+    /**
+     * @brief Slow path: runs the slow PIDs if @ref stepFast completed a
+     * decimated sample since the last call, e.g. as task of its own rate
+     * group once per `CountLim` ticks.
+     *
+     * @param sctrl_out Slow control output per channel, held in between.
+     */
+    void stepSlow(channels_t& sctrl_out)
+    {
+        channels_t slowSig;
+        if (TakeSlowSignal(slowSig)) {
+            runSlow(slowSig, sctrl_out);
+        }
+        sctrl_out = _sctrl;
+    }
+
+    /**
+     * @brief Takes the decimated sample completed by @ref stepFast since the
+     * last call, in the context of @ref stepFast.
+     *
+     * @return true if there was one.
+     */
+    bool TakeSlowSignal(channels_t& slowSig)
+    {
+        return _demodulator.TakeDecimated(slowSig);
+    }
+
+    /**
+     * @brief Slow PIDs on a decimated sample from @ref TakeSlowSignal.
+     *
+     * Shares no state with @ref stepFast, so it may run in a lower-priority
+     * interrupt that @ref stepFast preempts, with the sample handed over
+     * in between.
+     */
+    void runSlow(const channels_t& slowSig, channels_t& sctrl_out)
+    {
+        _pids.run(slowSig, _sctrl);
+        sctrl_out = _sctrl;
+    }
+
+  private:
+    template <class Pid>
+    static void m_set(Pid& pids, std::size_t channel, float p, float i, float d)
+    {
+        pids.set_p(channel, p);
+        pids.set_i(channel, i);
+        pids.set_d(channel, d);
+    }
+
+    Reference   _dds;
+    Demodulator _demodulator;
+    Filter      _filter;
+    FastPid     _pidf; // fast pids
+    SlowPid     _pids; // slow pids, state of runSlow only
+    channels_t  _sctrl{};
+};
@@ -1,12 +1,20 @@
 #pragma once
+#include "cic.hpp"
 #include "dds.hpp"
+#include "fir.hpp"
 #include "lockIn.hpp"
 #include "peripherals.hpp"
-#include <tsp/pid.hpp>
+#include <tsp/iir.hpp>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <math.h>
+#include <utility>
 namespace {
-const float   frq_pids = 1e3;
-const float   TS       = 1.0f / CtrlFreq;
-const int16_t CountLim = round(CtrlFreq / frq_pids);
+constexpr float   frq_pids = 1e3;
+constexpr float   TS       = 1.0f / CtrlFreq;
+constexpr int16_t CountLim = (int16_t)(CtrlFreq / frq_pids + 0.5f); // rounded, constant for rate groups
 } // namespace
 struct PIDParam
 {
@@ -17,17 +25,170 @@ struct PIDParam
     float kis; // slow controller ki
     float kds; // slow controller kd
 };
-class ControlLoop
+
+/**
+ * @brief Demodulator stage of the @ref ChannelEngine: multiplies the inputs
+ * with their references and decimates the products for the slow path, one
+ * CIC filter per channel, decimating in lockstep.
+ */
+template <std::size_t Channels>
+class CicDemodulator
 {
+  public:
+    using samples_t = std::array<float, Channels>;
+
+    explicit CicDemodulator(uint32_t decimation)
+      : _cic(m_cic(decimation, std::make_index_sequence<Channels>{}))
+    {
+    }
+
+    void Calc(const samples_t& input, const samples_t& reference, samples_t& demodulated)
+    {
+        for (std::size_t k = 0; k < Channels; k++) {
+            demodulated[k] = input[k] * reference[k];
+        }
+
+        bool decimated = false;
+        for (std::size_t k = 0; k < Channels; k++) {
+            decimated = _cic[k].Calc(demodulated[k], _decimated[k]);
+        }
+        _decimatedReady = _decimatedReady || decimated;
+    }
+
+    /**
+     * @brief Takes the decimated sample completed by @ref Calc since the last
+     * call.
+     *
+     * @return true if there was one.
+     */
+    bool TakeDecimated(samples_t& out)
+    {
+        if (!_decimatedReady) {
+            return false;
+        }
+        _decimatedReady = false;
+        out             = _decimated;
+        return true;
+    }
+
   private:
-    LockIn*                        _lockin;
-    int                            _count;
-    toptica::tsp::pid::pid<float>* _pidf; // fast pid
-    toptica::tsp::pid::pid<float>* _pids; // slow pid
+    template <std::size_t... Channel>
+    static std::array<Cic<CIC_ORDER>, Channels> m_cic(uint32_t decimation, std::index_sequence<Channel...>)
+    {
+        return {((void)Channel, Cic<CIC_ORDER>(decimation, CIC_FULL_SCALE))...};
+    }
+
+    std::array<Cic<CIC_ORDER>, Channels> _cic;
+    samples_t                            _decimated{};
+    bool                                 _decimatedReady = false;
+};
+
+/**
+ * @brief Filter stage of the @ref ChannelEngine: boxcar over one period of
+ * the given frequency, i.e. with its first zero there, per channel.
+ */
+template <std::size_t Channels>
+class BoxcarFilter : public BoxcarBank<float, Channels, FIR_MAX_LENGTH>
+{
+  public:
+    using setting_t = std::size_t; // length
+
+    explicit BoxcarFilter(float FIRfreq)
+      : BoxcarBank<float, Channels, FIR_MAX_LENGTH>(Setting(FIRfreq))
+    {
+    }
+
+    /**
+     * @brief Length of the boxcar with its first zero at @p FIRfreq.
+     */
+    static setting_t Setting(float FIRfreq)
+    {
+        return (std::size_t)std::lround(CtrlFreq / FIRfreq);
+    }
+
+    /**
+     * @brief Applies a length from @ref Setting, clears the averages if it
+     * changes.
+     */
+    void Apply(setting_t length)
+    {
+        if (length != this->Length()) {
+            this->SetLength(length);
+        }
+    }
+};
+
+/**
+ * @brief Filter stage of the @ref ChannelEngine: Butterworth low-pass of
+ * order @p Order with its -3 dB corner at the given frequency, per channel.
+ *
+ * One `tsp::iir::static_iir` per channel, i.e. the Direct Form 2 of
+ * `tsp::iir` on fixed arrays without heap.  The design is computed on
+ * construction and by @ref Setting; where the corner is a constant,
+ * `tsp::iir::butterworth` evaluates at compile time and the coefficient
+ * constructor takes its result.  In single precision keep the order low for
+ * corners far below the sampling rate.
+ */
+template <std::size_t Channels, std::size_t Order = 2>
+class IirFilter
+{
   public:
-    ControlLoop(const PIDParam& pid_param, DDSParam& dds_param, const float FIRfreq);
-    ~ControlLoop();
-    void                 step(float error, float& sctrl_out, float& fctrl_out);
-    float                test_dds();
-    std::array<float, 2> test_pid(float error);
-};
\ No newline at end of file
+    using coefficients_t = toptica::tsp::iir::coefficients<float, Order>;
+    using samples_t      = std::array<float, Channels>;
+    using setting_t      = coefficients_t;
+
+    explicit IirFilter(float cornerFreq)
+      : IirFilter(Setting(cornerFreq))
+    {
+    }
+    explicit constexpr IirFilter(const coefficients_t& coefficients)
+    {
+        SetCoefficients(coefficients);
+    }
+
+    /**
+     * @brief Butterworth design of the given corner.
+     */
+    static constexpr setting_t Setting(float cornerFreq)
+    {
+        return toptica::tsp::iir::butterworth<float, Order>(cornerFreq / CtrlFreq,
+                                                            toptica::tsp::filter::type::low_pass);
+    }
+
+    constexpr void SetCoefficients(const coefficients_t& coefficients)
+    {
+        for (auto& iir : _iir) {
+            iir.set_coefficients(coefficients);
+        }
+    }
+
+    const coefficients_t& Coefficients() const
+    {
+        return _iir[0].get_coefficients();
+    }
+
+    /**
+     * @brief Applies a design from @ref Setting, the filter states are kept.
+     */
+    void Apply(const setting_t& coefficients)
+    {
+        SetCoefficients(coefficients);
+    }
+
+    void Reset()
+    {
+        for (auto& iir : _iir) {
+            iir.reset();
+        }
+    }
+
+    void Calc(const samples_t& input, samples_t& output)
+    {
+        for (std::size_t k = 0; k < Channels; k++) {
+            output[k] = _iir[k].filter(input[k]);
+        }
+    }
+
+  private:
+    std::array<toptica::tsp::iir::static_iir<float, Order>, Channels> _iir{};
+};
@@ -1,9 +1,12 @@
 #undef __STRICT_ANSI__
 #define _USE_MATH_DEFINES
 #include "dds.hpp"
+#include <algorithm>
 #include <cmath>
+#include <type_traits>
 
-DDS::DDS(const DDSParam& dds_param)
+template <class Sine>
+BasicDDS<Sine>::BasicDDS(const DDSParam& dds_param)
   : _enable(dds_param.enable),
     _amp(dds_param.amp),
     _offset(dds_param.offset),
@@ -12,15 +15,496 @@ DDS::DDS(const DDSParam& dds_param)
     _phaseOffset(dds_param.phaseOffset),
     _accumulatorWidth(dds_param.accumulatorWidth),
     _LUTGridWidth(dds_param.LUTGridWidth),
-    _LUT(dds_param.LUT)
+    _LUT(dds_param.LUT),
+    _sine(m_sine(dds_param))
 {
-    auto phi     = _phaseOffset * M_PI / 180.0;
-    auto phi_lag = _phaseOffset_1ag * M_PI / 180.0;
-    _TW          = round((_freq) / ((_fclk) / (1 << _accumulatorWidth)));
-    _detTW       = round((phi - phi_lag) * (1 << _accumulatorWidth) / M_PI_2);
+    _TW    = TuningWord(_freq, _fclk, _accumulatorWidth);
+    _detTW = PhaseOffsetWord(_phaseOffset, _accumulatorWidth);
+
+    tuning_t tuning;
+    tuning.phaseStep  = (uint32_t)_TW << (32 - _accumulatorWidth);
+    tuning.phaseShift = (uint32_t)_detTW << (32 - _accumulatorWidth);
+    tuning.amp        = _amp;
+    tuning.offset     = _offset;
+    _tunings[0]       = tuning;
+}
+
+/**
+ * @brief Constructs the sine policy, from the LUT of the parameters if it takes one.
+ */
+template <class Sine>
+Sine BasicDDS<Sine>::m_sine(const DDSParam& dds_param)
+{
+    if constexpr (std::is_constructible_v<Sine, const SinusLUT<>&>) {
+        return Sine(dds_param.LUT);
+    } else {
+        return Sine();
+    }
+}
+
+/**
+ * @brief Precomputes the segments of a frequency sweep.
+ *
+ * A logarithmic sweep needs positive start and stop frequencies.  Both
+ * frequencies must be below `fclk / 2`.
+ */
+DDSSweep::DDSSweep(const DDSSweepParam& sweep_param)
+  : _mode(sweep_param.mode)
+{
+    const double   scale   = 18446744073709551616.0 / (double)sweep_param.fclk; // 2^64 / fclk
+    const double   start   = (double)sweep_param.startFreq * scale;
+    const double   stop    = (double)sweep_param.stopFreq * scale;
+    const uint32_t samples = std::max(sweep_param.samples, 1u);
+    const bool     linear  = (sweep_param.shape == SweepShape::linear);
+
+    _segments = linear ? 1 : std::min((uint32_t)MAX_SEGMENTS, samples);
+
+    uint32_t position = 0;
+    for (uint32_t i = 0; i < _segments; i++) {
+        auto x       = (double)position / samples;
+        _boundary[i] = (uint64_t)std::llround(linear ? start + (stop - start) * x : start * std::pow(stop / start, x));
+        _length[i]   = samples / _segments + ((i < samples % _segments) ? 1 : 0);
+        position += _length[i];
+    }
+    _boundary[_segments] = (uint64_t)std::llround(stop);
+
+    for (uint32_t i = 0; i < _segments; i++) {
+        _rate[i] = (int64_t)(_boundary[i + 1] - _boundary[i]) / (int64_t)_length[i];
+    }
+}
+
+/**
+ * @brief Returns the tuning word (phase increment per sample) in units of the
+ * accumulator width.
+ */
+template <class Sine>
+int BasicDDS<Sine>::TuningWord(float freq, float fclk, int accumulatorWidth)
+{
+    return (int)round((freq) / ((fclk) / (1 << accumulatorWidth)));
+}
+
+/**
+ * @brief Returns the phase offset [°] in units of the accumulator width.
+ */
+template <class Sine>
+int BasicDDS<Sine>::PhaseOffsetWord(float phaseOffset, int accumulatorWidth)
+{
+    return (int)std::lround(phaseOffset / 360.0f * (float)(1 << accumulatorWidth));
+}
+
+/**
+ * @brief Sets the output frequency.
+ *
+ * Takes effect with the next sample.  The phase accumulator is not touched,
+ * so the output phase is continuous.
+ */
+template <class Sine>
+void BasicDDS<Sine>::SetFrequency(float freq)
+{
+    auto tuning      = *_tuning.load(std::memory_order_relaxed);
+    tuning.phaseStep = (uint32_t)TuningWord(freq, _fclk, _accumulatorWidth) << (32 - _accumulatorWidth);
+    m_publish(tuning);
+}
+
+/**
+ * @brief Sets the phase offset [°] of the shifted output.
+ *
+ * Takes effect with the next sample.
+ */
+template <class Sine>
+void BasicDDS<Sine>::SetPhaseOffset(float phaseOffset)
+{
+    auto tuning       = *_tuning.load(std::memory_order_relaxed);
+    tuning.phaseShift = (uint32_t)PhaseOffsetWord(phaseOffset, _accumulatorWidth) << (32 - _accumulatorWidth);
+    m_publish(tuning);
+}
+
+/**
+ * @brief Sets amplitude and offset of the shifted output.
+ *
+ * Takes effect with the next sample.
+ */
+template <class Sine>
+void BasicDDS<Sine>::SetAmplitude(float amp, float offset)
+{
+    auto tuning   = *_tuning.load(std::memory_order_relaxed);
+    tuning.amp    = amp;
+    tuning.offset = offset;
+    m_publish(tuning);
+}
+
+/**
+ * @brief Selects the waveform of both outputs.
+ *
+ * Takes effect with the next sample, the phase is continuous.
+ */
+template <class Sine>
+void BasicDDS<Sine>::SetWaveform(Waveform waveform)
+{
+    auto tuning = *_tuning.load(std::memory_order_relaxed);
+    switch (waveform) {
+        case Waveform::sine:
+            tuning.wave = nullptr;
+            break;
+        case Waveform::triangle:
+            tuning.wave = &triangleTable;
+            break;
+        case Waveform::sawtooth:
+            tuning.wave = &sawtoothTable;
+            break;
+    }
+    m_publish(tuning);
+}
+
+/**
+ * @brief Selects a user waveform, e.g. from a @ref WaveTableBuffer.
+ *
+ * Takes effect with the next sample.  @p table is used by reference and must
+ * not be modified while in use.
+ */
+template <class Sine>
+void BasicDDS<Sine>::SetWaveform(const WaveTable<>& table)
+{
+    auto tuning = *_tuning.load(std::memory_order_relaxed);
+    tuning.wave = &table;
+    m_publish(tuning);
+}
+
+/**
+ * @brief Starts a frequency sweep with the next sample.
+ *
+ * Replaces the frequency of @ref SetFrequency until @ref StopSweep.  The
+ * phase stays continuous.  @p sweep is used by reference and must stay
+ * valid while it runs; starting the sweep that already runs continues it.
+ */
+template <class Sine>
+void BasicDDS<Sine>::StartSweep(const DDSSweep& sweep)
+{
+    _sweep.store(&sweep, std::memory_order_release);
+}
+
+/**
+ * @brief Stops the frequency sweep, the DDS returns to the frequency of @ref SetFrequency.
+ */
+template <class Sine>
+void BasicDDS<Sine>::StopSweep()
+{
+    _sweep.store(nullptr, std::memory_order_release);
+}
+
+/**
+ * @brief Returns the frequency of the next sample.
+ *
+ * Reads the sweep state of the sample calculation, so call it from the same
+ * context, e.g. to log a sweep along with the measurement.
+ */
+template <class Sine>
+float BasicDDS<Sine>::GetFrequency() const
+{
+    const uint32_t step = (_sweepRunning != nullptr) ? (uint32_t)(_sweepStep >> 32)
+                                                     : _tuning.load(std::memory_order_acquire)->phaseStep;
+    return (float)step * (_fclk / 4294967296.0f);
+}
+
+/**
+ * @brief Publishes a new parameter set to the sample calculation.
+ *
+ * Writes the inactive set and then switches to it, like the coefficient
+ * ping-pong of `tsp::pid`.  Meant for a single writer, e.g. the main loop,
+ * while the sample calculation runs in an interrupt: the interrupt always
+ * completes a sample before the writer continues, so the inactive set is
+ * never in use.
+ */
+template <class Sine>
+void BasicDDS<Sine>::m_publish(const tuning_t& tuning)
+{
+    const auto* active = _tuning.load(std::memory_order_relaxed);
+    auto*       next   = &_tunings[(active == &_tunings[0]) ? 1 : 0];
+
+    *next = tuning;
+    _tuning.store(next, std::memory_order_release);
+}
+
+/**
+ * @brief Returns the phase increment of the next sample.
+ *
+ * Without a sweep this is the tuning word of @p tuning.  While sweeping, the
+ * tuning word is advanced by one 64 bit add per sample; the segment logic
+ * only runs at the end of a segment.
+ */
+template <class Sine>
+inline uint32_t BasicDDS<Sine>::m_phaseStep(const tuning_t& tuning)
+{
+    const auto* sweep = _sweep.load(std::memory_order_acquire);
+
+    if (sweep != _sweepRunning) {
+        _sweepRunning = sweep;
+        if (sweep != nullptr) {
+            m_sweepSegment(0, false);
+        }
+    }
+    if (sweep == nullptr) {
+        return tuning.phaseStep;
+    }
+
+    const auto step = (uint32_t)(_sweepStep >> 32);
+    _sweepStep += (uint64_t)_sweepRate;
+    if (--_sweepRemaining == 0) {
+        m_sweepSegmentEnd();
+    }
+    return step;
+}
+
+/**
+ * @brief Interpolates the selected waveform at @p phase.
+ */
+template <class Sine>
+inline float BasicDDS<Sine>::m_interp(const tuning_t& tuning, uint32_t phase)
+{
+    return (tuning.wave == nullptr) ? _sine.Interp(phase) : tuning.wave->Interp(phase);
+}
+
+/**
+ * @brief Loads sweep segment @p segment, downwards starting at its end.
+ */
+template <class Sine>
+void BasicDDS<Sine>::m_sweepSegment(uint32_t segment, bool down)
+{
+    const auto& sweep = *_sweepRunning;
+
+    _sweepSegment   = segment;
+    _sweepDown      = down;
+    _sweepRemaining = sweep._length[segment];
+    _sweepStep      = down ? sweep._boundary[segment + 1] : sweep._boundary[segment];
+    _sweepRate      = down ? -sweep._rate[segment] : sweep._rate[segment];
+}
+
+/**
+ * @brief Continues the sweep at the end of a segment according to the sweep mode.
+ *
+ * Each segment starts at its exact boundary, so the rounding of the
+ * increments does not accumulate over the segments or the repetitions.
+ */
+template <class Sine>
+void BasicDDS<Sine>::m_sweepSegmentEnd()
+{
+    const auto& sweep = *_sweepRunning;
+
+    if (_sweepDown) {
+        if (_sweepSegment > 0) {
+            m_sweepSegment(_sweepSegment - 1, true);
+        } else {
+            m_sweepSegment(0, false);
+        }
+        return;
+    }
+    if (_sweepSegment + 1 < sweep._segments) {
+        m_sweepSegment(_sweepSegment + 1, false);
+        return;
+    }
+
+    switch (sweep._mode) {
+        case SweepMode::single:
+            _sweepStep      = sweep._boundary[sweep._segments];
+            _sweepRate      = 0;
+            _sweepRemaining = UINT32_MAX;
+            break;
+        case SweepMode::repeat:
+            m_sweepSegment(0, false);
+            break;
+        case SweepMode::triangle:
+            m_sweepSegment(sweep._segments - 1, true);
+            break;
+    }
+}
+
+/**
+ * @brief Calculates the next DDS sample using the integer phase accumulator.
+ *
+ * The phase offset is applied as a constant phase word, thus no float
+ * division, no wrap logic and no phase offset bookkeeping runs per sample.
+ * The output matches @ref CalcFloat within float rounding and is
+ * bit-identical to the sine table interpolated at the accumulated phase
+ * word, like every @ref DDSBank tone.
+ */
+template <class Sine>
+void BasicDDS<Sine>::Calc(float& out, float& shift_out)
+{
+    const auto& tuning = *_tuning.load(std::memory_order_acquire);
+
+    _phase += m_phaseStep(tuning);
+
+    if (_enable) {
+        if (tuning.wave == nullptr) {
+            _sine.InterpShifted(_phase, tuning.phaseShift, out, shift_out);
+        } else {
+            out       = tuning.wave->Interp(_phase);
+            shift_out = tuning.wave->Interp(_phase + tuning.phaseShift);
+        }
+        shift_out = shift_out * tuning.amp + tuning.offset;
+    } else {
+        out       = 0.0;
+        shift_out = 0.0;
+    }
 }
 
-void DDS::Calc(float& out, float& shift_out)
+/**
+ * @brief Calculates the next DDS sample as in-phase and quadrature component.
+ *
+ * Returns sine and cosine of the shifted phase, both scaled like `shift_out`
+ * of @ref Calc, from a single LUT phase-to-index step.  @p i_out equals
+ * `shift_out` of @ref Calc.
+ */
+template <class Sine>
+void BasicDDS<Sine>::CalcIQ(float& i_out, float& q_out)
+{
+    const auto& tuning = *_tuning.load(std::memory_order_acquire);
+
+    _phase += m_phaseStep(tuning);
+
+    if (_enable) {
+        float sin, cos;
+        if (tuning.wave == nullptr) {
+            _sine.InterpIQ(_phase + tuning.phaseShift, sin, cos);
+        } else {
+            sin = tuning.wave->Interp(_phase + tuning.phaseShift);
+            cos = tuning.wave->Interp(_phase + tuning.phaseShift + 0x40000000u);
+        }
+        i_out = sin * tuning.amp + tuning.offset;
+        q_out = cos * tuning.amp + tuning.offset;
+    } else {
+        i_out = 0.0;
+        q_out = 0.0;
+    }
+}
+
+/**
+ * @brief Advances the phase accumulator like @ref Calc and returns the
+ * shifted phase word instead of the sample.
+ *
+ * For consumers deriving several references from the one phase, e.g. the
+ * harmonics n * phase of the harmonic lock-in: the integer multiplication
+ * wraps exactly like the accumulator of a DDS at n times the frequency.
+ * Amplitude, offset, waveform and the enable flag do not apply.
+ */
+template <class Sine>
+uint32_t BasicDDS<Sine>::CalcPhase()
+{
+    const auto& tuning = *_tuning.load(std::memory_order_acquire);
+
+    _phase += m_phaseStep(tuning);
+    return _phase + tuning.phaseShift;
+}
+
+/**
+ * @brief Calculates the next @p n DDS samples.
+ *
+ * Fills @p out with the `shift_out` samples of @p n consecutive @ref Calc
+ * calls.  The loop works on local copies of the state and has no branches,
+ * so the compiler can keep everything in registers (and vectorize it on the
+ * host).  While a sweep runs, it falls back to the per-sample calculation.
+ */
+template <class Sine>
+void BasicDDS<Sine>::CalcBlock(float* out, std::size_t n)
+{
+    const auto& tuning = *_tuning.load(std::memory_order_acquire);
+
+    if (_sweepRunning != nullptr || _sweep.load(std::memory_order_relaxed) != nullptr) {
+        for (std::size_t k = 0; k < n; k++) {
+            _phase += m_phaseStep(tuning);
+            out[k] = _enable ? m_interp(tuning, _phase + tuning.phaseShift) * tuning.amp + tuning.offset : 0.0f;
+        }
+        return;
+    }
+
+    if (!_enable) {
+        std::fill(out, out + n, 0.0f);
+        _phase += tuning.phaseStep * (uint32_t)n;
+        return;
+    }
+
+    const uint32_t step   = tuning.phaseStep;
+    const uint32_t shift  = tuning.phaseShift;
+    const float    amp    = tuning.amp;
+    const float    offset = tuning.offset;
+    uint32_t       phase  = _phase;
+
+    if (tuning.wave != nullptr) {
+        const auto& wave = *tuning.wave;
+        for (std::size_t k = 0; k < n; k++) {
+            phase += step;
+            out[k] = wave.Interp(phase + shift) * amp + offset;
+        }
+    } else {
+        for (std::size_t k = 0; k < n; k++) {
+            phase += step;
+            out[k] = _sine.Interp(phase + shift) * amp + offset;
+        }
+    }
+    _phase = phase;
+}
+
+/**
+ * @brief Calculates the next @p n DDS samples as in-phase and quadrature component.
+ *
+ * Block variant of @ref CalcIQ, see @ref CalcBlock.
+ */
+template <class Sine>
+void BasicDDS<Sine>::CalcIQBlock(float* i_out, float* q_out, std::size_t n)
+{
+    const auto& tuning = *_tuning.load(std::memory_order_acquire);
+
+    if (_sweepRunning != nullptr || _sweep.load(std::memory_order_relaxed) != nullptr) {
+        for (std::size_t k = 0; k < n; k++) {
+            CalcIQ(i_out[k], q_out[k]);
+        }
+        return;
+    }
+
+    if (!_enable) {
+        std::fill(i_out, i_out + n, 0.0f);
+        std::fill(q_out, q_out + n, 0.0f);
+        _phase += tuning.phaseStep * (uint32_t)n;
+        return;
+    }
+
+    const uint32_t step   = tuning.phaseStep;
+    const uint32_t shift  = tuning.phaseShift;
+    const float    amp    = tuning.amp;
+    const float    offset = tuning.offset;
+    uint32_t       phase  = _phase;
+
+    if (tuning.wave != nullptr) {
+        const auto& wave = *tuning.wave;
+        for (std::size_t k = 0; k < n; k++) {
+            phase += step;
+            i_out[k] = wave.Interp(phase + shift) * amp + offset;
+            q_out[k] = wave.Interp(phase + shift + 0x40000000u) * amp + offset;
+        }
+    } else {
+        for (std::size_t k = 0; k < n; k++) {
+            float sin, cos;
+            phase += step;
+            _sine.InterpIQ(phase + shift, sin, cos);
+            i_out[k] = sin * amp + offset;
+            q_out[k] = cos * amp + offset;
+        }
+    }
+    _phase = phase;
+}
+
+/**
+ * @brief Calculates the next DDS sample using the float LUT index.
+ *
+ * Reference implementation of @ref Calc for the parameters given on
+ * construction, the setters do not apply to it.  Accumulates the phase in
+ * the integer range of the accumulator width, converts it to a float
+ * full-wave LUT index and interpolates linearly between the sine at the
+ * grid points of the table, so it shares neither the phase word nor the
+ * quarter-wave slopes with @ref Calc.
+ */
+template <class Sine>
+void BasicDDS<Sine>::CalcFloat(float& out, float& shift_out)
 {
     _TWSum += _TW;
     auto phase_out = _TWSum;
@@ -35,22 +519,35 @@ void DDS::Calc(float& out, float& shift_out)
 
     auto phase_outShift = _TWSumShift;
     if (phase_outShift > (1 << _accumulatorWidth) - 1) {
-        phase_outShift = phase_outShift - (1 << _accumulatorWidth) + 1;
+        phase_outShift = phase_outShift - (1 << _accumulatorWidth);
         _TWSumShift    = phase_outShift;
     }
     if (phase_out > (1 << _accumulatorWidth) - 1) {
-        phase_out = phase_out - (1 << _accumulatorWidth) + 1;
+        phase_out = phase_out - (1 << _accumulatorWidth);
         _TWSum    = phase_out;
     }
 
     auto _LUTIndexShift = (float)phase_outShift / (float)((1 << (_accumulatorWidth - _LUTGridWidth)));
     auto _LUTIndex      = (float)phase_out / (float)((1 << (_accumulatorWidth - _LUTGridWidth)));
 
+    const uint32_t gridMask = (1u << _LUTGridWidth) - 1;
+    auto           interp   = [&](float index) {
+        const auto  grid     = (uint32_t)index;
+        const float fraction = index - (float)grid;
+        const float value    = _LUT.Grid(grid);
+        return value + (_LUT.Grid((grid + 1) & gridMask) - value) * fraction;
+    };
+
     if (_enable) {
-        out       = _LUT.Interp(_LUTIndex);
-        shift_out = _LUT.Interp(_LUTIndexShift) * _amp + _offset;
+        out       = interp(_LUTIndex);
+        shift_out = interp(_LUTIndexShift) * _amp + _offset;
     } else {
         out       = 0.0;
         shift_out = 0.0;
     }
 }
+
+template class BasicDDS<LUTSine>;
+template class BasicDDS<BasicLUTSine<256>>;
+template class BasicDDS<CordicSine>;
+template class BasicDDS<ResonatorSine>;
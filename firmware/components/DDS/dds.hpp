@@ -1,18 +1,94 @@
 #pragma once
+#include "sinePolicy.hpp"
 #include "sinusLUT.hpp"
+#include "waveTable.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 struct DDSParam
 {
-    bool      enable;
-    float     amp;
-    float     offset;
-    float     freq;
-    float     phaseOffset;
-    float     fclk;
-    int       accumulatorWidth;
-    int       LUTGridWidth;
-    SinusLUT& LUT;
+    bool              enable;
+    float             amp;
+    float             offset;
+    float             freq;
+    float             phaseOffset;
+    float             fclk;
+    int               accumulatorWidth;
+    int               LUTGridWidth;
+    const SinusLUT<>& LUT;
 };
-class DDS
+
+enum class Waveform
+{
+    sine,
+    triangle,
+    sawtooth,
+};
+
+enum class SweepShape
+{
+    linear,
+    logarithmic,
+};
+
+enum class SweepMode
+{
+    single,   // sweep once, then hold the stop frequency
+    repeat,   // restart at the start frequency
+    triangle, // sweep back to the start frequency, then up again
+};
+
+struct DDSSweepParam
+{
+    float      startFreq;
+    float      stopFreq;
+    uint32_t   samples; // duration of one sweep from start to stop frequency
+    SweepShape shape;
+    SweepMode  mode;
+    float      fclk;
+};
+
+/**
+ * @brief Frequency sweep (chirp) of a @ref DDS.
+ *
+ * The sweep is a chain of segments with a constant tuning word increment, so
+ * the DDS only adds the increment to the tuning word per sample.  A linear
+ * sweep is a single segment, a logarithmic sweep is approximated by
+ * `MAX_SEGMENTS` segments with geometric spaced boundaries.  All float math
+ * runs here, on construction.
+ */
+class DDSSweep
+{
+  public:
+    static constexpr std::size_t MAX_SEGMENTS = 32;
+
+    DDSSweep(const struct DDSSweepParam& sweep_param);
+
+  private:
+    template <class Sine>
+    friend class BasicDDS;
+
+    // Tuning words in 32.32 fixed point of the phase word, so also slow
+    // sweeps have an exact increment.
+    std::array<uint64_t, MAX_SEGMENTS + 1> _boundary{};
+    std::array<int64_t, MAX_SEGMENTS>      _rate{};
+    std::array<uint32_t, MAX_SEGMENTS>     _length{};
+
+    uint32_t  _segments = 0;
+    SweepMode _mode     = SweepMode::single;
+};
+
+/**
+ * @brief Direct digital synthesizer.
+ *
+ * @tparam Sine Sine generation policy, see sinePolicy.hpp: @ref LUTSine
+ *              (@ref DDS) or @ref BasicLUTSine of another table length
+ *              (@ref CompactDDS), @ref CordicSine or @ref ResonatorSine.
+ *              Other waveforms always use their @ref WaveTable.
+ */
+template <class Sine>
+class BasicDDS
 {
   private:
     bool  _enable          = true;
@@ -30,11 +106,70 @@ class DDS
 
     int _accumulatorWidth = 0;
     int _LUTGridWidth     = 0;
-    ;
 
-    SinusLUT _LUT;
+    const SinusLUT<>& _LUT; // of the float reference CalcFloat
+
+    // Integer phase accumulator: the accumulator width is left aligned in 32 bits,
+    // so the phase wraps on the unsigned overflow and the LUT index and the
+    // interpolation fraction are just the upper and lower bits of the phase word.
+    uint32_t _phase = 0;
+
+    // Parameters used by the sample calculation.  The setters write the
+    // inactive one of the two sets and then publish it, so the calculation
+    // always sees a consistent set, switched at a sample boundary.
+    struct tuning_t
+    {
+        uint32_t phaseStep  = 0;
+        uint32_t phaseShift = 0;
+        float    amp        = 0.0;
+        float    offset     = 0.0;
+
+        const WaveTable<>* wave = nullptr; // nullptr: sine from the policy
+    };
+    std::array<tuning_t, 2>      _tunings{};
+    std::atomic<const tuning_t*> _tuning{&_tunings[0]};
+
+    Sine _sine;
+
+    // Sweep state, owned by the sample calculation.  `_sweep` is set from
+    // the thread context, the calculation picks it up at the next sample.
+    std::atomic<const DDSSweep*> _sweep{nullptr};
+    const DDSSweep*              _sweepRunning   = nullptr;
+    uint64_t                     _sweepStep      = 0;
+    int64_t                      _sweepRate      = 0;
+    uint32_t                     _sweepRemaining = 0;
+    uint32_t                     _sweepSegment   = 0;
+    bool                         _sweepDown      = false;
+
+    void     m_publish(const tuning_t& tuning);
+    uint32_t m_phaseStep(const tuning_t& tuning);
+    float    m_interp(const tuning_t& tuning, uint32_t phase);
+    void     m_sweepSegment(uint32_t segment, bool down);
+    void     m_sweepSegmentEnd();
+
+    static Sine m_sine(const DDSParam& dds_param);
 
   public:
-    DDS(const struct DDSParam& dds_param);
-    void Calc(float& out, float& shift_out);
+    BasicDDS(const struct DDSParam& dds_param);
+    static int TuningWord(float freq, float fclk, int accumulatorWidth);
+    static int PhaseOffsetWord(float phaseOffset, int accumulatorWidth);
+    void       SetFrequency(float freq);
+    void       SetPhaseOffset(float phaseOffset);
+    void       SetAmplitude(float amp, float offset);
+    void       SetWaveform(Waveform waveform);
+    void       SetWaveform(const WaveTable<>& table);
+    void       StartSweep(const DDSSweep& sweep);
+    void       StopSweep();
+    float      GetFrequency() const;
+    void       Calc(float& out, float& shift_out);
+    void       CalcIQ(float& i_out, float& q_out);
+    uint32_t   CalcPhase();
+    void       CalcBlock(float* out, std::size_t n);
+    void       CalcIQBlock(float* i_out, float* q_out, std::size_t n);
+    void       CalcFloat(float& out, float& shift_out);
 };
+
+using DDS          = BasicDDS<LUTSine>;
+using CompactDDS   = BasicDDS<BasicLUTSine<256>>; // 2 KB sine table
+using CordicDDS    = BasicDDS<CordicSine>;
+using ResonatorDDS = BasicDDS<ResonatorSine>;
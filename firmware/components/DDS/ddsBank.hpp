@@ -0,0 +1,147 @@
+#pragma once
+#include "dds.hpp"
+#include "sinusLUT.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Tuning of one tone of a @ref DDSBank as it is applied: phase words
+ * of the 32 bit accumulator and output scaling, zero if disabled.  Plain
+ * values, computed by @ref DDSBank::Tone outside the context of the bank.
+ */
+struct DDSTone
+{
+    uint32_t phaseStep;
+    uint32_t phaseShift;
+    float    amp;
+    float    offset;
+};
+
+/**
+ * @brief A bank of DDS tones sharing one sine table.
+ *
+ * The state of all tones is kept in struct-of-arrays layout (phase
+ * accumulators, tuning words, amplitudes, ...), so one call advances all
+ * tones in a single loop over contiguous arrays.  The bank is sized at
+ * compile time and needs no heap.  Every tone produces the same samples as
+ * the `shift_out` of a @ref DDS constructed with the same parameters.
+ *
+ * @tparam N         Number of tones.
+ * @tparam LUTLength Number of quarter-wave sine table entries, see @ref
+ *                   BasicLUTSine.
+ */
+template <std::size_t N, std::size_t LUTLength = LUT_LENGTH>
+class DDSBank
+{
+  public:
+    explicit DDSBank(const SinusLUT<LUTLength>& LUT = sharedSinusLUT<LUTLength>);
+
+    static DDSTone Tone(const DDSParam& dds_param);
+
+    void SetTone(std::size_t tone, const DDSParam& dds_param);
+    void Retune(std::size_t tone, const DDSParam& dds_param);
+    void Retune(std::size_t tone, const DDSTone& tuning);
+    void Calc(std::array<float, N>& out);
+    void CalcIQ(std::array<float, N>& i_out, std::array<float, N>& q_out);
+
+  private:
+    std::array<uint32_t, N> _phase{};
+    std::array<uint32_t, N> _phaseStep{};
+    std::array<uint32_t, N> _phaseShift{};
+    std::array<float, N>    _amp{};
+    std::array<float, N>    _offset{};
+
+    const SinusLUT<LUTLength>& _LUT;
+};
+
+/**
+ * @param LUT The sine table shared by all tones.  All tones are silent until
+ *            configured with @ref SetTone.
+ */
+template <std::size_t N, std::size_t LUTLength>
+DDSBank<N, LUTLength>::DDSBank(const SinusLUT<LUTLength>& LUT) : _LUT(LUT)
+{
+}
+
+/**
+ * @brief Phase words and scaling of a tone.  Uses the double precision
+ * math of @ref DDS::TuningWord, so call it in the thread context and hand
+ * the result to @ref Retune.
+ */
+template <std::size_t N, std::size_t LUTLength>
+DDSTone DDSBank<N, LUTLength>::Tone(const DDSParam& dds_param)
+{
+    const int shift = 32 - dds_param.accumulatorWidth;
+
+    DDSTone tuning;
+    tuning.phaseStep  = (uint32_t)DDS::TuningWord(dds_param.freq, dds_param.fclk, dds_param.accumulatorWidth) << shift;
+    tuning.phaseShift = (uint32_t)DDS::PhaseOffsetWord(dds_param.phaseOffset, dds_param.accumulatorWidth) << shift;
+    tuning.amp        = dds_param.enable ? dds_param.amp : 0.0f;
+    tuning.offset     = dds_param.enable ? dds_param.offset : 0.0f;
+    return tuning;
+}
+
+/**
+ * @brief Configures a tone and resets its phase accumulator.
+ *
+ * A disabled tone outputs zero, but its phase keeps running.
+ */
+template <std::size_t N, std::size_t LUTLength>
+void DDSBank<N, LUTLength>::SetTone(std::size_t tone, const DDSParam& dds_param)
+{
+    _phase[tone] = 0;
+    Retune(tone, dds_param);
+}
+
+/**
+ * @brief Configures a tone keeping its phase, i.e. without phase
+ * discontinuity.  Takes effect with the next sample; call it from the
+ * context of @ref Calc.  Computes the phase words with @ref Tone: where
+ * that context is an interrupt, retune with the words instead.
+ */
+template <std::size_t N, std::size_t LUTLength>
+void DDSBank<N, LUTLength>::Retune(std::size_t tone, const DDSParam& dds_param)
+{
+    Retune(tone, Tone(dds_param));
+}
+
+/**
+ * @brief Retunes a tone to phase words from @ref Tone, only stores them.
+ */
+template <std::size_t N, std::size_t LUTLength>
+void DDSBank<N, LUTLength>::Retune(std::size_t tone, const DDSTone& tuning)
+{
+    _phaseStep[tone]  = tuning.phaseStep;
+    _phaseShift[tone] = tuning.phaseShift;
+    _amp[tone]        = tuning.amp;
+    _offset[tone]     = tuning.offset;
+}
+
+/**
+ * @brief Advances all tones by one sample.
+ */
+template <std::size_t N, std::size_t LUTLength>
+void DDSBank<N, LUTLength>::Calc(std::array<float, N>& out)
+{
+    for (std::size_t k = 0; k < N; k++) {
+        _phase[k] += _phaseStep[k];
+        out[k] = _LUT.Interp(_phase[k] + _phaseShift[k]) * _amp[k] + _offset[k];
+    }
+}
+
+/**
+ * @brief Advances all tones by one sample, returning in-phase and quadrature
+ * components like @ref DDS::CalcIQ.
+ */
+template <std::size_t N, std::size_t LUTLength>
+void DDSBank<N, LUTLength>::CalcIQ(std::array<float, N>& i_out, std::array<float, N>& q_out)
+{
+    for (std::size_t k = 0; k < N; k++) {
+        float sin, cos;
+        _phase[k] += _phaseStep[k];
+        _LUT.InterpIQ(_phase[k] + _phaseShift[k], sin, cos);
+        i_out[k] = sin * _amp[k] + _offset[k];
+        q_out[k] = cos * _amp[k] + _offset[k];
+    }
+}
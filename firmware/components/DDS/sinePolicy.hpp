@@ -0,0 +1,264 @@
+#pragma once
+#include "sinusLUT.hpp"
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * Sine generation policies of the DDS (see BasicDDS).  Each maps a 32-bit
+ * phase word (full scale = 2π) to the sine and provides
+ *
+ *   float Interp(uint32_t phase);
+ *   void  InterpIQ(uint32_t phase, float& sin, float& cos);
+ *   void  InterpShifted(uint32_t phase, uint32_t shift, float& sin, float& sinShifted);
+ *
+ * A policy is constructed from the `SinusLUT` of the DDS parameters if it
+ * takes one, else default constructed.
+ */
+
+namespace sine_policy_detail {
+constexpr double sqrt(double x)
+{
+    double root = (x > 1.0) ? x : 1.0;
+    for (int n = 0; n < 64; n++) {
+        root = 0.5 * (root + x / root);
+    }
+    return root;
+}
+
+// atan(2^-i), i = 0 is π/4, otherwise the series converges for x <= 1/2
+constexpr double atan_pow2(int i)
+{
+    if (i == 0) {
+        return sinus_lut_detail::pi / 4.0;
+    }
+    const double x    = 1.0 / (double)(1ull << i);
+    double       term = x;
+    double       sum  = 0.0;
+    for (int n = 0; n < 40; n++) {
+        sum += term / (double)(2 * n + 1);
+        term *= -x * x;
+    }
+    return sum;
+}
+
+// CORDIC rotation angles atan(2^-i) in phase word units
+template <int Iterations>
+struct cordic_angles
+{
+    int32_t value[(std::size_t)Iterations]{};
+
+    constexpr cordic_angles()
+    {
+        for (int i = 0; i < Iterations; i++) {
+            const double turns = atan_pow2(i) / (2.0 * sinus_lut_detail::pi);
+            value[i]           = (int32_t)(turns * 4294967296.0 + 0.5);
+        }
+    }
+};
+
+// 1 / CORDIC gain in Q1.30, so the result has unit amplitude
+constexpr int32_t cordic_gain(int iterations)
+{
+    double gain = 1.0;
+    for (int i = 0; i < iterations; i++) {
+        gain /= sqrt(1.0 + 1.0 / (double)(1ull << (2 * i)));
+    }
+    return (int32_t)(gain * (double)(1u << 30) + 0.5);
+}
+} // namespace sine_policy_detail
+
+/**
+ * @brief Sine from the quarter-wave look-up table with linear interpolation
+ * (default).
+ *
+ * Fastest, but the table (8 KB with the slopes at the default length)
+ * competes for the cache with the rest of the control loop; a shorter table
+ * trades spectral purity for cache footprint.  Constructed from the LUT of
+ * the DDS parameters if it has this length, else from the shared table of
+ * the length.
+ *
+ * @tparam Length Number of quarter-wave table entries, see @ref SinusLUT.
+ */
+template <std::size_t Length = LUT_LENGTH>
+class BasicLUTSine
+{
+  public:
+    explicit BasicLUTSine(const SinusLUT<Length>& LUT = sharedSinusLUT<Length>)
+      : _LUT(LUT)
+    {
+    }
+
+    float Interp(uint32_t phase) const
+    {
+        return _LUT.Interp(phase);
+    }
+
+    void InterpIQ(uint32_t phase, float& sin, float& cos) const
+    {
+        _LUT.InterpIQ(phase, sin, cos);
+    }
+
+    void InterpShifted(uint32_t phase, uint32_t shift, float& sin, float& sinShifted) const
+    {
+        sin        = _LUT.Interp(phase);
+        sinShifted = _LUT.Interp(phase + shift);
+    }
+
+  private:
+    const SinusLUT<Length>& _LUT;
+};
+
+using LUTSine = BasicLUTSine<>;
+
+/**
+ * @brief Sine from an integer CORDIC with a fixed number of iterations.
+ *
+ * Needs no table besides the 24 arc tangents and runs in constant time, at
+ * the cost of one shift-add iteration per bit of precision.
+ */
+class CordicSine
+{
+  public:
+    static constexpr int iterations = 24;
+
+    /**
+     * @brief Rotates the unit vector to @p phase: sine and cosine in one run.
+     *
+     * The phase is reduced to [-π/2, π/2] (rotating by π negates the result),
+     * then rotated in Q1.30 fixed point with angles in phase word units.
+     */
+    static void Rotate(uint32_t phase, float& sin, float& cos)
+    {
+        int32_t z      = (int32_t)phase;
+        int32_t negate = 1;
+        if (z > (1 << 30) || z < -(1 << 30)) {
+            z      = (int32_t)(phase + 0x80000000u);
+            negate = -1;
+        }
+
+        int32_t x = _gain;
+        int32_t y = 0;
+        for (int i = 0; i < iterations; i++) {
+            // rotate towards z = 0 without branches: (v ^ d) - d negates v for z < 0
+            const int32_t d  = z >> 31;
+            const int32_t dx = y >> i;
+            const int32_t dy = x >> i;
+            x -= (dx ^ d) - d;
+            y += (dy ^ d) - d;
+            z -= (_angle.value[i] ^ d) - d;
+        }
+
+        const float scale = (float)negate * (1.0f / (float)(1u << 30));
+        sin               = (float)y * scale;
+        cos               = (float)x * scale;
+    }
+
+    float Interp(uint32_t phase) const
+    {
+        float sin, cos;
+        Rotate(phase, sin, cos);
+        return sin;
+    }
+
+    void InterpIQ(uint32_t phase, float& sin, float& cos) const
+    {
+        Rotate(phase, sin, cos);
+    }
+
+    void InterpShifted(uint32_t phase, uint32_t shift, float& sin, float& sinShifted) const
+    {
+        sin        = Interp(phase);
+        sinShifted = Interp(phase + shift);
+    }
+
+  private:
+    static constexpr sine_policy_detail::cordic_angles<iterations> _angle{};
+    static constexpr int32_t                                       _gain = sine_policy_detail::cordic_gain(iterations);
+};
+
+/**
+ * @brief Sine from a renormalized recursive resonator.
+ *
+ * Rotates the state vector (cos, sin) by the phase step of the last call,
+ * i.e. one complex multiplication plus a first-order amplitude correction
+ * per sample, without any table.  The rotation is taken from @ref CordicSine
+ * whenever the phase step changes, and the state is resynchronized to the
+ * exact phase every `RESYNC` samples to bound the phase drift.  Suits fixed
+ * tones: during a sweep every sample falls back to the CORDIC.
+ *
+ * This deliberately is not the Goertzel-style two-term recursion
+ * y[n] = 2 cos(ω) y[n-1] - y[n-2].  That recursion needs one multiply per
+ * sample but returns only the sine, so the quadrature and the shifted output
+ * would need further recursions, and its coefficient rounding changes the
+ * frequency by Δk / (2 sin(ω)), which drifts quickly at low tuning words.
+ * The rotation keeps unit amplitude at any step for four multiplies plus the
+ * correction.  A retune costs two CORDIC rotations, the periodic resync one,
+ * see `benchmark-dds-sine`.
+ *
+ * The resonator follows a single phase sequence, use one instance per DDS.
+ */
+class ResonatorSine
+{
+  public:
+    static constexpr uint32_t RESYNC = 256;
+
+    float Interp(uint32_t phase)
+    {
+        m_advance(phase);
+        return _sin;
+    }
+
+    void InterpIQ(uint32_t phase, float& sin, float& cos)
+    {
+        m_advance(phase);
+        sin = _sin;
+        cos = _cos;
+    }
+
+    void InterpShifted(uint32_t phase, uint32_t shift, float& sin, float& sinShifted)
+    {
+        m_advance(phase);
+        if (shift != _shift) {
+            _shift = shift;
+            CordicSine::Rotate(shift, _shiftSin, _shiftCos);
+        }
+        sin        = _sin;
+        sinShifted = _sin * _shiftCos + _cos * _shiftSin;
+    }
+
+  private:
+    void m_advance(uint32_t phase)
+    {
+        const uint32_t step = phase - _phase;
+        _phase              = phase;
+
+        if (step != _step || --_resync == 0) {
+            if (step != _step) {
+                _step = step;
+                CordicSine::Rotate(step, _stepSin, _stepCos);
+            }
+            CordicSine::Rotate(phase, _sin, _cos);
+            _resync = RESYNC;
+            return;
+        }
+
+        const float sin  = _sin * _stepCos + _cos * _stepSin;
+        const float cos  = _cos * _stepCos - _sin * _stepSin;
+        const float gain = 1.5f - 0.5f * (sin * sin + cos * cos);
+        _sin             = sin * gain;
+        _cos             = cos * gain;
+    }
+
+    uint32_t _phase  = 0;
+    uint32_t _step   = 0;
+    uint32_t _resync = 1;
+    float    _sin    = 0.0f;
+    float    _cos    = 1.0f;
+
+    float _stepSin = 0.0f;
+    float _stepCos = 1.0f;
+
+    uint32_t _shift    = 0;
+    float    _shiftSin = 0.0f;
+    float    _shiftCos = 1.0f;
+};
@@ -1,14 +1,188 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
 
 #define LUT_LENGTH 1024
 
+namespace sinus_lut_detail {
+constexpr double pi = 3.14159265358979323846;
+
+/**
+ * @brief Sine for the compile-time table generation (std::sin is not constexpr).
+ *
+ * Range reduction to [-π/2, π/2] followed by the Taylor series, which is
+ * exact to double precision there after 12 terms.
+ */
+constexpr double sin(double x)
+{
+    while (x > pi) {
+        x -= 2.0 * pi;
+    }
+    while (x < -pi) {
+        x += 2.0 * pi;
+    }
+    if (x > pi / 2.0) {
+        x = pi - x;
+    } else if (x < -pi / 2.0) {
+        x = -pi - x;
+    }
+
+    double term = x;
+    double sum  = x;
+    for (int n = 1; n < 12; n++) {
+        term *= -x * x / (double)((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr int log2(std::size_t value)
+{
+    int bits = 0;
+    while (value > 1) {
+        value >>= 1;
+        bits++;
+    }
+    return bits;
+}
+} // namespace sinus_lut_detail
+
+/**
+ * @brief Quarter-wave sine look-up table with precomputed slopes, generated at
+ * compile time.
+ *
+ * The table stores sin() over [0, π/2) plus the slope to the next entry, the
+ * other three quadrants are derived by symmetry.  This gives four times the
+ * angular resolution of a full-wave table of the same size, and the
+ * interpolation is a single multiply-add.
+ *
+ * Declare instances `constexpr` (like @ref sinusLUT) so the table is placed
+ * in flash and no sine is evaluated at startup.
+ *
+ * @tparam Length Number of quarter-wave table entries, a power of two.
+ */
+template <std::size_t Length = LUT_LENGTH>
 class SinusLUT
 {
+    static_assert(Length >= 2 && (Length & (Length - 1)) == 0, "LUT length must be a power of two!");
+
   public:
-    SinusLUT();
-    float Interp(float index);
+    static constexpr std::size_t length = Length;
+    static constexpr int         bits   = sinus_lut_detail::log2(Length) + 2; // full-wave index bits
+
+    constexpr SinusLUT();
+    float Interp(uint32_t phase) const;
+    float Lookup(uint32_t phase) const;
+    float Grid(uint32_t index) const;
+    void  InterpIQ(uint32_t phase, float& sin, float& cos) const;
 
   private:
-    int   _LUTX[LUT_LENGTH];
-    float _LUTd[LUT_LENGTH];
+    static constexpr int _quarterBits  = bits - 2;
+    static constexpr int _fractionBits = 30 - _quarterBits;
+
+    float _value[Length]{};
+    float _slope[Length]{};
 };
+
+template <std::size_t Length>
+constexpr SinusLUT<Length>::SinusLUT()
+{
+    const double step = sinus_lut_detail::pi / 2.0 / (double)Length;
+    for (std::size_t li = 0; li < Length; li++) {
+        const double value = sinus_lut_detail::sin(step * (double)li);
+        const double next  = sinus_lut_detail::sin(step * (double)(li + 1));
+        _value[li]         = (float)value;
+        _slope[li]         = (float)(next - value);
+    }
+}
+
+/**
+ * @brief Interpolates the sine at a 32-bit phase word (full scale = 2π).
+ *
+ * The upper two bits are the quadrant.  In the second and fourth quadrant the
+ * phase within the quadrant is mirrored (by inverting its bits), in the third
+ * and fourth quadrant the result is negated.  The next @ref bits - 2 bits are
+ * the table index, the remaining lower bits the interpolation fraction.
+ */
+template <std::size_t Length>
+float SinusLUT<Length>::Interp(uint32_t phase) const
+{
+    const uint32_t mirror   = (uint32_t)((int32_t)(phase << 1) >> 31);
+    const uint32_t quarter  = (phase ^ mirror) & 0x3fffffffu;
+    const uint32_t index    = quarter >> _fractionBits;
+    const float    fraction = (float)(quarter & ((1u << _fractionBits) - 1)) * (1.0f / (float)(1u << _fractionBits));
+    const float    sign     = (float)(1 - (int32_t)((phase >> 30) & 2u));
+
+    return ((_slope[index] * fraction) + _value[index]) * sign;
+}
+
+/**
+ * @brief Looks up the sine at a 32-bit phase word without interpolation.
+ *
+ * Truncates the phase to the table grid like @ref Interp but skips the
+ * multiply-add, for comparing the interpolation against the plain table.
+ */
+template <std::size_t Length>
+float SinusLUT<Length>::Lookup(uint32_t phase) const
+{
+    const uint32_t mirror  = (uint32_t)((int32_t)(phase << 1) >> 31);
+    const uint32_t quarter = (phase ^ mirror) & 0x3fffffffu;
+    const float    sign    = (float)(1 - (int32_t)((phase >> 30) & 2u));
+
+    return _value[quarter >> _fractionBits] * sign;
+}
+
+/**
+ * @brief Returns the sine at full-wave grid point @p index, i.e. at
+ * 2π * index / 2^@ref bits.
+ *
+ * Derived from the quarter-wave table by exact symmetry, without the phase
+ * word and its bit-inverting mirror, for the float reference of the DDS.
+ */
+template <std::size_t Length>
+float SinusLUT<Length>::Grid(uint32_t index) const
+{
+    const uint32_t quadrant = (index >> _quarterBits) & 3u;
+    const uint32_t position = index & (Length - 1);
+    const float    value    = (position == 0 && (quadrant & 1u) != 0) ? 1.0f
+                              : ((quadrant & 1u) != 0)                 ? _value[Length - position]
+                                                                       : _value[position];
+    return (quadrant >= 2) ? -value : value;
+}
+
+/**
+ * @brief Interpolates sine and cosine at a 32-bit phase word (full scale = 2π).
+ *
+ * Both share one phase-to-index step: cos(φ) = sin(φ + π/2) lies in the next
+ * quadrant, whose mirroring is the opposite of the current one, so its
+ * position within the quadrant is the bitwise complement of the sine's.  The
+ * results are identical to Interp(phase) and Interp(phase + 2^30).
+ */
+template <std::size_t Length>
+void SinusLUT<Length>::InterpIQ(uint32_t phase, float& sin, float& cos) const
+{
+    const uint32_t fractionMask = (1u << _fractionBits) - 1;
+    const uint32_t mirror       = (uint32_t)((int32_t)(phase << 1) >> 31);
+    const uint32_t quarter      = (phase ^ mirror) & 0x3fffffffu;
+    const uint32_t index        = quarter >> _fractionBits;
+    const uint32_t indexCos     = (Length - 1) - index;
+    const float    scale        = 1.0f / (float)(1u << _fractionBits);
+    const float    fraction     = (float)(quarter & fractionMask) * scale;
+    const float    fractionCos  = (float)(~quarter & fractionMask) * scale;
+    const float    sign         = (float)(1 - (int32_t)((phase >> 30) & 2u));
+    const float    signCos      = (float)(1 - (int32_t)(((phase + 0x40000000u) >> 30) & 2u));
+
+    sin = ((_slope[index] * fraction) + _value[index]) * sign;
+    cos = ((_slope[indexCos] * fractionCos) + _value[indexCos]) * signCos;
+}
+
+/**
+ * @brief The sine table of each length, shared by all DDS instances using it.
+ */
+template <std::size_t Length = LUT_LENGTH>
+inline constexpr SinusLUT<Length> sharedSinusLUT{};
+
+/**
+ * @brief The sine table of the default length @ref LUT_LENGTH.
+ */
+inline constexpr const SinusLUT<>& sinusLUT = sharedSinusLUT<>;
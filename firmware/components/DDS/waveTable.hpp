@@ -0,0 +1,127 @@
+#pragma once
+#include "sinusLUT.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#define WAVE_TABLE_LENGTH 256
+
+/**
+ * @brief Full-wave look-up table of an arbitrary periodic waveform with
+ * precomputed slopes.
+ *
+ * Used by the @ref DDS for other waveforms than the sine, with the same
+ * phase word and the same single multiply-add interpolation as
+ * @ref SinusLUT.  Triangle and sawtooth are linear between the grid points,
+ * so their tables (@ref triangleTable, @ref sawtoothTable) interpolate
+ * exactly.
+ *
+ * @tparam Length Number of table entries over one period, a power of two.
+ */
+template <std::size_t Length = WAVE_TABLE_LENGTH>
+class WaveTable
+{
+    static_assert(Length >= 2 && (Length & (Length - 1)) == 0, "Wave table length must be a power of two!");
+
+  public:
+    static constexpr std::size_t length = Length;
+    static constexpr int         bits   = sinus_lut_detail::log2(Length);
+
+    constexpr WaveTable() = default;
+
+    static constexpr WaveTable Triangle();
+    static constexpr WaveTable Sawtooth();
+
+    void  Load(const float* samples);
+    float Interp(uint32_t phase) const;
+
+  private:
+    static constexpr int _fractionBits = 32 - bits;
+
+    float _value[Length]{};
+    float _slope[Length]{};
+};
+
+/**
+ * @brief Triangle with the phase of the sine: 0 at 0, 1 at π/2, -1 at 3π/2.
+ */
+template <std::size_t Length>
+constexpr WaveTable<Length> WaveTable<Length>::Triangle()
+{
+    WaveTable table;
+    for (std::size_t li = 0; li < Length; li++) {
+        const auto quarter = (double)(4 * li) / (double)Length;
+        const auto value   = (quarter < 1.0) ? quarter : (quarter < 3.0) ? 2.0 - quarter : quarter - 4.0;
+        table._value[li]   = (float)value;
+        table._slope[li]   = (float)((quarter < 1.0 || quarter >= 3.0) ? 4.0 : -4.0) / (float)Length;
+    }
+    return table;
+}
+
+/**
+ * @brief Rising sawtooth with the phase of the sine: 0 at 0, steps from 1 to -1 at π.
+ */
+template <std::size_t Length>
+constexpr WaveTable<Length> WaveTable<Length>::Sawtooth()
+{
+    WaveTable table;
+    for (std::size_t li = 0; li < Length; li++) {
+        const auto half  = (double)(2 * li) / (double)Length;
+        table._value[li] = (float)((half < 1.0) ? half : half - 2.0);
+        table._slope[li] = 2.0f / (float)Length;
+    }
+    return table;
+}
+
+/**
+ * @brief Loads one period of @ref length samples, the waveform wraps from
+ * the last to the first sample.
+ */
+template <std::size_t Length>
+void WaveTable<Length>::Load(const float* samples)
+{
+    for (std::size_t li = 0; li < Length; li++) {
+        _value[li] = samples[li];
+        _slope[li] = samples[(li + 1) % Length] - samples[li];
+    }
+}
+
+/**
+ * @brief Interpolates the waveform at a 32-bit phase word (full scale = one period).
+ */
+template <std::size_t Length>
+float WaveTable<Length>::Interp(uint32_t phase) const
+{
+    const uint32_t index    = phase >> _fractionBits;
+    const float    fraction = (float)(phase & ((1u << _fractionBits) - 1)) * (1.0f / (float)(1u << _fractionBits));
+
+    return (_slope[index] * fraction) + _value[index];
+}
+
+/**
+ * @brief Double-buffered user waveform.
+ *
+ * @ref Load writes the buffer not handed out by the previous call, so a
+ * waveform running in the DDS is never overwritten: load the new samples,
+ * then pass the returned table to `DDS::SetWaveform`.
+ */
+class WaveTableBuffer
+{
+  public:
+    const WaveTable<>& Load(const float* samples)
+    {
+        _active = (_active + 1) % _tables.size();
+        _tables[_active].Load(samples);
+        return _tables[_active];
+    }
+
+  private:
+    std::array<WaveTable<>, 2> _tables{};
+    std::size_t                _active = 0;
+};
+
+/**
+ * @brief The triangle and sawtooth tables shared by all DDS instances.
+ */
+inline constexpr auto triangleTable = WaveTable<>::Triangle();
+inline constexpr auto sawtoothTable = WaveTable<>::Sawtooth();
@@ -1,17 +1,436 @@
 #pragma once
-namespace {
-const int BUFFER_LEN = 1000;
-} // namespace
-class FIR
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace fir_detail {
+/**
+ * @brief Mirrored circular delay line: every input is written at its
+ * position and one length behind, so the last @p Length inputs are always
+ * contiguous, newest first, at @ref data.
+ */
+template <typename T, std::size_t Length>
+class delay_line
 {
   public:
-    float FIR_ACCUMULATOR[BUFFER_LEN];
-    int   ACCUMLen;
-    float FIR_Freq;
-    float FIR_Calc(float Input);
-    FIR(float Freq);
+    void push(T input)
+    {
+        _index                   = (_index == 0) ? Length - 1 : _index - 1;
+        _buffer[_index]          = input;
+        _buffer[_index + Length] = input;
+    }
+
+    const T* data() const
+    {
+        return &_buffer[_index];
+    }
+
+    void reset()
+    {
+        _buffer.fill(T{});
+        _index = 0;
+    }
 
   private:
-    float SUMME;
-    int   Idx;
-};
\ No newline at end of file
+    std::array<T, 2 * Length> _buffer{};
+    std::size_t               _index = 0;
+};
+
+template <typename T, std::size_t Length>
+T dot(const std::array<T, Length>& h, const T* x)
+{
+    T sum = T{};
+    for (std::size_t k = 0; k < Length; k++) {
+        sum += h[k] * x[k];
+    }
+    return sum;
+}
+} // namespace fir_detail
+
+/**
+ * @brief Streaming FIR filter with compile-time length.
+ *
+ * The delay line is a mirrored circular buffer of twice the filter length:
+ * every input is written at its position and one filter length behind, so
+ * the last @p Taps inputs are always contiguous and the multiply-accumulate
+ * loop runs over two plain arrays without index wrapping.
+ *
+ * @tparam T    Sample and coefficient type.
+ * @tparam Taps Number of coefficients.
+ */
+template <typename T, std::size_t Taps>
+class Fir
+{
+    static_assert(Taps > 0, "FIR needs at least one tap!");
+
+  public:
+    using coefficients_t = std::array<T, Taps>;
+
+    constexpr Fir() = default;
+    explicit constexpr Fir(const coefficients_t& coefficients)
+      : _coefficients(coefficients)
+    {
+    }
+
+    void SetCoefficients(const coefficients_t& coefficients)
+    {
+        _coefficients = coefficients;
+    }
+
+    /**
+     * @brief Clears the delay line.
+     */
+    void Reset()
+    {
+        _delay.reset();
+    }
+
+    /**
+     * @brief Filters one sample, the first coefficient weights the newest input.
+     */
+    T Calc(T input)
+    {
+        _delay.push(input);
+        return fir_detail::dot(_coefficients, _delay.data());
+    }
+
+    /**
+     * @brief Filters @p n samples, @p in and @p out may be the same array.
+     */
+    void CalcBlock(const T* in, T* out, std::size_t n)
+    {
+        for (std::size_t k = 0; k < n; k++) {
+            out[k] = Calc(in[k]);
+        }
+    }
+
+  private:
+    coefficients_t                  _coefficients{};
+    fir_detail::delay_line<T, Taps> _delay{};
+};
+
+/**
+ * @brief Decimating FIR filter, polyphase: computes only the kept outputs.
+ *
+ * Equals a @ref Fir of which only every @p Factor-th output (the last of
+ * each group of @p Factor inputs) is kept, but the inputs in between are
+ * only stored, so the cost is @p Taps / @p Factor multiply-adds per input.
+ *
+ * @tparam T      Sample and coefficient type.
+ * @tparam Taps   Number of coefficients.
+ * @tparam Factor Decimation factor.
+ */
+template <typename T, std::size_t Taps, std::size_t Factor>
+class FirDecimator
+{
+    static_assert(Taps > 0 && Factor > 0, "FIR decimator needs at least one tap and a factor of at least one!");
+
+  public:
+    using coefficients_t = std::array<T, Taps>;
+
+    constexpr FirDecimator() = default;
+    explicit constexpr FirDecimator(const coefficients_t& coefficients)
+      : _coefficients(coefficients)
+    {
+    }
+
+    void SetCoefficients(const coefficients_t& coefficients)
+    {
+        _coefficients = coefficients;
+    }
+
+    void Reset()
+    {
+        _delay.reset();
+        _count = 0;
+    }
+
+    /**
+     * @brief Feeds one input sample.
+     *
+     * @return true if the sample completed an output sample in @p output.
+     */
+    bool Calc(T input, T& output)
+    {
+        _delay.push(input);
+        if (++_count < Factor) {
+            return false;
+        }
+        _count = 0;
+        output = fir_detail::dot(_coefficients, _delay.data());
+        return true;
+    }
+
+    /**
+     * @brief Feeds @p n input samples, writes the completed outputs to @p out.
+     *
+     * @return Number of output samples, at most n / Factor + 1.  @p in and
+     *         @p out may be the same array.
+     */
+    std::size_t CalcBlock(const T* in, T* out, std::size_t n)
+    {
+        std::size_t outputs = 0;
+        for (std::size_t k = 0; k < n; k++) {
+            if (Calc(in[k], out[outputs])) {
+                outputs++;
+            }
+        }
+        return outputs;
+    }
+
+  private:
+    coefficients_t                  _coefficients{};
+    fir_detail::delay_line<T, Taps> _delay{};
+    std::size_t                     _count = 0;
+};
+
+/**
+ * @brief Interpolating FIR filter, polyphase: computes only the non-zero
+ * products.
+ *
+ * Equals a @ref Fir fed with each input followed by @p Factor - 1 zeros.
+ * The coefficients are split into @p Factor phases of Taps / Factor
+ * coefficients each, output p after an input uses phase p, so the zeros are
+ * never multiplied.  For unit gain the coefficients sum to @p Factor.
+ *
+ * @tparam T      Sample and coefficient type.
+ * @tparam Taps   Number of coefficients.
+ * @tparam Factor Interpolation factor.
+ */
+template <typename T, std::size_t Taps, std::size_t Factor>
+class FirInterpolator
+{
+    static_assert(Taps > 0 && Factor > 0, "FIR interpolator needs at least one tap and a factor of at least one!");
+
+  public:
+    using coefficients_t = std::array<T, Taps>;
+
+    constexpr FirInterpolator() = default;
+    explicit FirInterpolator(const coefficients_t& coefficients)
+    {
+        SetCoefficients(coefficients);
+    }
+
+    void SetCoefficients(const coefficients_t& coefficients)
+    {
+        for (std::size_t p = 0; p < Factor; p++) {
+            for (std::size_t k = 0; k < _phaseTaps; k++) {
+                const std::size_t tap = k * Factor + p;
+                _phases[p][k]         = (tap < Taps) ? coefficients[tap] : T{};
+            }
+        }
+    }
+
+    void Reset()
+    {
+        _delay.reset();
+    }
+
+    /**
+     * @brief Filters one input sample into @p Factor output samples.
+     */
+    void Calc(T input, T* output)
+    {
+        _delay.push(input);
+        const T* x = _delay.data();
+        for (std::size_t p = 0; p < Factor; p++) {
+            output[p] = fir_detail::dot(_phases[p], x);
+        }
+    }
+
+    /**
+     * @brief Filters @p n input samples into n * Factor output samples.
+     */
+    void CalcBlock(const T* in, T* out, std::size_t n)
+    {
+        for (std::size_t k = 0; k < n; k++) {
+            Calc(in[k], &out[k * Factor]);
+        }
+    }
+
+  private:
+    static constexpr std::size_t _phaseTaps = (Taps + Factor - 1) / Factor;
+
+    std::array<std::array<T, _phaseTaps>, Factor> _phases{};
+    fir_detail::delay_line<T, _phaseTaps>         _delay{};
+};
+
+/**
+ * @brief Moving average (boxcar) with compile-time storage and run-time length.
+ *
+ * The special case of @ref Fir with equal coefficients, as running sum: one
+ * add and one subtract per sample, independent of the length.  The running
+ * sum does not drift: integer samples are summed exactly in 64 bit, floating
+ * point samples with Kahan compensation, so the rounding errors of adding a
+ * sample and of removing it again cancel.
+ *
+ * @tparam T         Sample type.
+ * @tparam MaxLength Maximum number of averaged samples, sizes the buffer.
+ */
+template <typename T, std::size_t MaxLength>
+class Boxcar
+{
+    static_assert(MaxLength > 0, "Boxcar needs at least one sample!");
+
+  public:
+    explicit Boxcar(std::size_t length = MaxLength)
+    {
+        SetLength(length);
+    }
+
+    /**
+     * @brief Sets the number of averaged samples, limited to [1, MaxLength],
+     * and clears the average.
+     */
+    void SetLength(std::size_t length)
+    {
+        _length = (length < 1) ? 1 : (length > MaxLength) ? MaxLength : length;
+        _scale  = (scale_t)1 / (scale_t)_length;
+        Reset();
+    }
+
+    std::size_t Length() const
+    {
+        return _length;
+    }
+
+    void Reset()
+    {
+        _buffer.fill(T{});
+        _index        = 0;
+        _sum          = sum_t{};
+        _compensation = sum_t{};
+    }
+
+    T Calc(T input)
+    {
+        const T oldest  = _buffer[_index];
+        _buffer[_index] = input;
+        _index          = (_index + 1 < _length) ? _index + 1 : 0;
+
+        if constexpr (std::is_integral_v<T>) {
+            _sum += (sum_t)input - (sum_t)oldest;
+            return (T)(_sum / (sum_t)_length);
+        } else {
+            m_add(input);
+            m_add(-oldest);
+            return (_sum - _compensation) * _scale;
+        }
+    }
+
+  private:
+    using sum_t   = std::conditional_t<std::is_integral_v<T>, int64_t, T>;
+    using scale_t = std::conditional_t<std::is_integral_v<T>, float, T>;
+
+    // Kahan summation: _compensation keeps the low-order bits lost in _sum
+    void m_add(sum_t value)
+    {
+        const sum_t y = value - _compensation;
+        const sum_t t = _sum + y;
+        _compensation = (t - _sum) - y;
+        _sum          = t;
+    }
+
+    std::array<T, MaxLength> _buffer{};
+    std::size_t              _length       = MaxLength;
+    std::size_t              _index        = 0;
+    sum_t                    _sum          = sum_t{};
+    sum_t                    _compensation = sum_t{};
+    scale_t                  _scale        = 1;
+};
+
+/**
+ * @brief @p Channels moving averages of common length, e.g. one per laser
+ * channel.
+ *
+ * Same results as one @ref Boxcar per channel, floating point only.  The
+ * delay line is interleaved, one row of @p Channels samples per time step,
+ * so a sample of all channels reads and writes one contiguous row; sums and
+ * Kahan compensations are arrays over the channels.
+ *
+ * @tparam T         Sample type.
+ * @tparam Channels  Number of channels.
+ * @tparam MaxLength Maximum number of averaged samples, sizes the buffer.
+ */
+template <typename T, std::size_t Channels, std::size_t MaxLength>
+class BoxcarBank
+{
+    static_assert(std::is_floating_point_v<T>, "Boxcar bank supports floating point samples only!");
+    static_assert(Channels > 0 && MaxLength > 0, "Boxcar bank needs at least one channel and one sample!");
+
+  public:
+    using samples_t = std::array<T, Channels>;
+
+    explicit BoxcarBank(std::size_t length = MaxLength)
+    {
+        SetLength(length);
+    }
+
+    /**
+     * @brief Sets the number of averaged samples, limited to [1, MaxLength],
+     * and clears the averages, see @ref Reset.
+     */
+    void SetLength(std::size_t length)
+    {
+        _length = (length < 1) ? 1 : (length > MaxLength) ? MaxLength : length;
+        _scale  = (T)1 / (T)_length;
+        Reset();
+    }
+
+    std::size_t Length() const
+    {
+        return _length;
+    }
+
+    /**
+     * @brief Clears the averages at a cost independent of the length: the
+     * delay line keeps its samples, they count as zero until overwritten.
+     */
+    void Reset()
+    {
+        _index  = 0;
+        _filled = 0;
+        _sum.fill(T{});
+        _compensation.fill(T{});
+    }
+
+    void Calc(const samples_t& input, samples_t& output)
+    {
+        auto&      row  = _buffer[_index];
+        const bool full = _filled == _length;
+        _filled         = full ? _filled : _filled + 1;
+        _index          = (_index + 1 < _length) ? _index + 1 : 0;
+
+        for (std::size_t k = 0; k < Channels; k++) {
+            // in locals: the stores to output could alias the members
+            T       sum          = _sum[k];
+            T       compensation = _compensation[k];
+            const T oldest       = full ? row[k] : T{};
+            row[k]               = input[k];
+            m_add(sum, compensation, input[k]);
+            m_add(sum, compensation, -oldest);
+            _sum[k]          = sum;
+            _compensation[k] = compensation;
+            output[k]        = (sum - compensation) * _scale;
+        }
+    }
+
+  private:
+    // Kahan summation as in Boxcar
+    static void m_add(T& sum, T& compensation, T value)
+    {
+        const T y    = value - compensation;
+        const T t    = sum + y;
+        compensation = (t - sum) - y;
+        sum          = t;
+    }
+
+    std::array<samples_t, MaxLength> _buffer{};
+    std::size_t                      _length = MaxLength;
+    std::size_t                      _index  = 0;
+    std::size_t                      _filled = 0; // samples since the reset, up to _length
+    samples_t                        _sum{};
+    samples_t                        _compensation{};
+    T                                _scale = 1;
+};
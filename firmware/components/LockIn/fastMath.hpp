@@ -0,0 +1,68 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+
+/*
+ * Square root and arc tangent for the lock-in outputs, without library
+ * calls and with a bounded error over the whole float range.
+ */
+namespace fast_math {
+const float PI = 3.14159265358979f;
+
+const float SQRT_MAX_RELATIVE_ERROR = 5e-6f;  // bound of fast_math::sqrt, relative
+const float ATAN2_MAX_ERROR         = 1.5e-5f; // bound of fast_math::atan2 [rad]
+
+/**
+ * @brief Square root as x / sqrt(x), the reciprocal square root from the
+ * exponent halving bit trick refined by two Newton steps.
+ *
+ * No division, relative error below @ref SQRT_MAX_RELATIVE_ERROR for normal
+ * positive @p x, 0 for @p x <= 0.
+ */
+inline float sqrt(float x)
+{
+    if (!(x > 0.0f)) {
+        return 0.0f;
+    }
+    uint32_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    bits = 0x5f375a86u - (bits >> 1);
+    float rsqrt;
+    std::memcpy(&rsqrt, &bits, sizeof(rsqrt));
+
+    const float half = 0.5f * x;
+    rsqrt            = rsqrt * (1.5f - half * rsqrt * rsqrt);
+    rsqrt            = rsqrt * (1.5f - half * rsqrt * rsqrt);
+    return x * rsqrt;
+}
+
+/**
+ * @brief Four-quadrant arc tangent in (-π, π].
+ *
+ * Reduces to an octant, min / max in [0, 1], and evaluates the odd
+ * polynomial of Abramowitz and Stegun 4.4.49 there (error 1e-5 rad).  The
+ * total error is below @ref ATAN2_MAX_ERROR, atan2(0, 0) is 0.
+ */
+inline float atan2(float y, float x)
+{
+    const float ax = (x < 0.0f) ? -x : x;
+    const float ay = (y < 0.0f) ? -y : y;
+    const float mx = (ax > ay) ? ax : ay;
+    const float mn = (ax > ay) ? ay : ax;
+    if (mx == 0.0f) {
+        return 0.0f;
+    }
+
+    const float t  = mn / mx;
+    const float t2 = t * t;
+    float       a  = t * (0.9998660f + t2 * (-0.3302995f + t2 * (0.1801410f + t2 * (-0.0851330f + t2 * 0.0208351f))));
+
+    if (ay > ax) {
+        a = 0.5f * PI - a;
+    }
+    if (x < 0.0f) {
+        a = PI - a;
+    }
+    return (y < 0.0f) ? -a : a;
+}
+} // namespace fast_math
@@ -0,0 +1,67 @@
+#include "harmonicLockIn.hpp"
+#include "fastMath.hpp"
+#include "peripherals.hpp"
+#include <cmath>
+
+HarmonicLockIn::HarmonicLockIn(DDSParam& dds_param, float FIRFreq, const uint32_t* harmonics, std::size_t count)
+  : dds(dds_param), _LUT(dds_param.LUT)
+{
+    const auto length = (std::size_t)std::lround(CtrlFreq / FIRFreq);
+    for (std::size_t k = 0; k < MAX_HARMONICS; k++) {
+        _firI[k].SetLength(length);
+        _firQ[k].SetLength(length);
+    }
+    SetHarmonics(harmonics, count);
+}
+/**
+ * @brief Selects the demodulated harmonics, at most @ref MAX_HARMONICS, and
+ * clears their filters.  Not to be called concurrently with @ref Run.
+ */
+void HarmonicLockIn::SetHarmonics(const uint32_t* harmonics, std::size_t count)
+{
+    _count = (count > MAX_HARMONICS) ? MAX_HARMONICS : count;
+    for (std::size_t k = 0; k < _count; k++) {
+        _harmonics[k] = harmonics[k];
+        _firI[k].Reset();
+        _firQ[k].Reset();
+        _x[k] = 0.0f;
+        _y[k] = 0.0f;
+    }
+}
+std::size_t HarmonicLockIn::Harmonics() const
+{
+    return _count;
+}
+uint32_t HarmonicLockIn::Harmonic(std::size_t index) const
+{
+    return _harmonics[index];
+}
+/**
+ * @brief Advances the reference by one sample and demodulates @p PD_sig at
+ * all selected harmonics.
+ */
+void HarmonicLockIn::Run(float PD_sig)
+{
+    const uint32_t phase = dds.CalcPhase();
+    for (std::size_t k = 0; k < _count; k++) {
+        float sin, cos;
+        _LUT.InterpIQ(phase * _harmonics[k], sin, cos);
+        _x[k] = _firI[k].Calc(PD_sig * sin);
+        _y[k] = _firQ[k].Calc(PD_sig * cos);
+    }
+}
+/**
+ * @brief Returns X, Y, R and θ of the harmonic at @p index of the selection.
+ *
+ * R and θ are calculated here, not in @ref Run, so the ISR only pays for
+ * the outputs actually read.
+ */
+LockInIQ HarmonicLockIn::Output(std::size_t index) const
+{
+    LockInIQ out;
+    out.x     = _x[index];
+    out.y     = _y[index];
+    out.r     = fast_math::sqrt(out.x * out.x + out.y * out.y);
+    out.theta = fast_math::atan2(out.y, out.x);
+    return out;
+}
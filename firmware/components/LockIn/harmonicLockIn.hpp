@@ -0,0 +1,42 @@
+#pragma once
+#include "dds.hpp"
+#include "fir.hpp"
+#include "lockIn.hpp"
+#include "sinusLUT.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+namespace {
+const std::size_t MAX_HARMONICS = 3; // harmonics demodulated per sample
+} // namespace
+
+/**
+ * @brief Lock-in demodulating a set of harmonics (e.g. 1f, 2f, 3f) of one
+ * DDS reference in one pass over the input sample.
+ *
+ * The references are sine and cosine of n times the DDS phase word, the
+ * integer multiplication wraps like the accumulator of a DDS at n times the
+ * frequency, so no extra DDS is needed and all harmonics stay phase locked
+ * to the fundamental.  The phase offset of the DDS is multiplied as well.
+ * Each harmonic has its I and Q low-pass as @ref LockIn::LockIn_runIQ.
+ */
+class HarmonicLockIn
+{
+  public:
+    DDS dds;
+    HarmonicLockIn(DDSParam& dds_param, float FIRFreq, const uint32_t* harmonics, std::size_t count);
+    void        SetHarmonics(const uint32_t* harmonics, std::size_t count);
+    std::size_t Harmonics() const;
+    uint32_t    Harmonic(std::size_t index) const;
+    void        Run(float input);
+    LockInIQ    Output(std::size_t index) const;
+
+  private:
+    const SinusLUT<>&                                        _LUT;
+    std::size_t                                              _count = 0;
+    std::array<uint32_t, MAX_HARMONICS>                      _harmonics{};
+    std::array<Boxcar<float, FIR_MAX_LENGTH>, MAX_HARMONICS> _firI;
+    std::array<Boxcar<float, FIR_MAX_LENGTH>, MAX_HARMONICS> _firQ;
+    std::array<float, MAX_HARMONICS>                         _x{};
+    std::array<float, MAX_HARMONICS>                         _y{};
+};
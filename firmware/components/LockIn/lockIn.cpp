@@ -1,24 +1,61 @@
 #include "lockIn.hpp"
 #include "dds.hpp"
+#include "fastMath.hpp"
 #include "fir.hpp"
 #include "peripherals.hpp"
 #include "sinusLUT.hpp"
+#include <cmath>
 
-LockIn::LockIn(DDSParam& dds_param, float FIRFreq)
+LockIn::LockIn(DDSParam& dds_param, float FIRFreq, uint32_t decimation)
+  : dds(dds_param),
+    fir((std::size_t)std::lround(CtrlFreq / FIRFreq)),
+    firQ(fir.Length()),
+    cic(decimation, CIC_FULL_SCALE),
+    _LUT(dds_param.LUT)
 {
-    SinusLUT sinus_sig;
-    dds = new DDS(dds_param);
-    fir = new FIR(FIRFreq);
 }
 float LockIn::LockIn_run(float PD_sig)
 {
     float dds_output;
     float dds_output_shift;
-    dds->Calc(dds_output, dds_output_shift);
-    return fir->FIR_Calc(PD_sig * dds_output_shift);
+    dds.Calc(dds_output, dds_output_shift);
+    const float demodulated = PD_sig * dds_output_shift;
+    _decimatedReady         = cic.Calc(demodulated, _decimated);
+    return fir.Calc(demodulated);
 }
-LockIn::~LockIn()
+/**
+ * @brief Dual-phase lock-in: demodulates with sine and cosine of the DDS
+ * phase and low-passes both with the same filter.
+ *
+ * As in @ref HarmonicLockIn the references are the unit sine and cosine of
+ * the phase word, not the DDS output, whose offset would add the DC level
+ * of the input to X and Y.  X equals the output of @ref LockIn_run at amplitude 1 and offset 0,
+ * but the phase of the reference no longer has to be tuned by hand: R does
+ * not depend on it and θ measures it.
+ * R and θ use @ref fast_math::sqrt and @ref fast_math::atan2.  Call either
+ * this or @ref LockIn_run every sample, not both.
+ */
+LockInIQ LockIn::LockIn_runIQ(float PD_sig)
 {
-    delete dds;
-    delete fir;
+    float sin, cos;
+    _LUT.InterpIQ(dds.CalcPhase(), sin, cos);
+    const float demodulated = PD_sig * sin;
+    _decimatedReady         = cic.Calc(demodulated, _decimated);
+
+    LockInIQ out;
+    out.x     = fir.Calc(demodulated);
+    out.y     = firQ.Calc(PD_sig * cos);
+    out.r     = fast_math::sqrt(out.x * out.x + out.y * out.y);
+    out.theta = fast_math::atan2(out.y, out.x);
+    return out;
+}
+/**
+ * @brief Returns the CIC decimated lock-in signal for the slow path.
+ *
+ * @return true if the last @ref LockIn_run completed a decimated sample.
+ */
+bool LockIn::LockIn_decimated(float& out) const
+{
+    out = _decimated;
+    return _decimatedReady;
 }
\ No newline at end of file
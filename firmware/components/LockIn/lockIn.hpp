@@ -1,14 +1,44 @@
 #pragma once
+#include "cic.hpp"
 #include "dds.hpp"
 #include "fir.hpp"
+#include "peripherals.hpp"
 #include "sinusLUT.hpp"
+#include <cstddef>
+#include <cstdint>
+namespace {
+const std::size_t FIR_MAX_LENGTH = 1000;                       // lowest FIR frequency CtrlFreq / FIR_MAX_LENGTH = 100 Hz
+const int         CIC_ORDER      = 3;                          // decimator of the slow path
+const float       DDS_MAX_OUTPUT = 2.0f;                       // DDS amplitude plus offset of the reference
+const float       CIC_FULL_SCALE = PDMaxVolt * DDS_MAX_OUTPUT; // largest demodulated PD signal [V]
+} // namespace
+
+/**
+ * @brief Outputs of the dual-phase lock-in: in-phase and quadrature
+ * component and their magnitude and phase [rad].
+ */
+struct LockInIQ
+{
+    float x;
+    float y;
+    float r;
+    float theta;
+};
 
 class LockIn
 {
   public:
-    DDS* dds;
-    FIR* fir;
-    LockIn(DDSParam& dds_param, float FIRFreq);
-    ~LockIn();
-    float LockIn_run(float input);
+    DDS                           dds;
+    Boxcar<float, FIR_MAX_LENGTH> fir;
+    Boxcar<float, FIR_MAX_LENGTH> firQ; // quadrature low-pass of LockIn_runIQ
+    Cic<CIC_ORDER>                cic;
+    LockIn(DDSParam& dds_param, float FIRFreq, uint32_t decimation);
+    float    LockIn_run(float input);
+    LockInIQ LockIn_runIQ(float input);
+    bool     LockIn_decimated(float& out) const;
+
+  private:
+    const SinusLUT<>& _LUT;
+    bool              _decimatedReady = false;
+    float             _decimated      = 0.0f;
 };
\ No newline at end of file
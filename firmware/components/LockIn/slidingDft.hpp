@@ -0,0 +1,183 @@
+#pragma once
+#include "fastMath.hpp"
+#include "lockIn.hpp"
+#include "peripherals.hpp"
+#include "sinusLUT.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Sliding DFT of the input at @p Bins chosen frequencies over the
+ * last `Length()` samples, for watching modulation harmonics and pick-up
+ * lines of the photodiode signal live, next to the lock-in.
+ *
+ * Modulated form: each bin keeps the running sum of the input times its
+ * reference sin/cos(φ), its phase word φ advancing like a DDS accumulator.
+ * Per sample the newest product is added and the one leaving the window
+ * subtracted, so the work is O(Bins) independent of the window length.
+ * The references come from the DDS sine table.  As in @ref Cic the
+ * products are quantized to 32 bit of the given full scale and summed in
+ * 64 bit; the product leaving the window is recomputed from the stored
+ * input and the phase word of then, i.e. equal to the one added, so the
+ * sums are exact and do not drift however long the bank runs.  Unlike the
+ * recursive sliding DFT, which rotates its state by a twiddle factor every
+ * sample, no rounding error of the twiddles accumulates, and the bins need
+ * not lie on the fs / Length grid.
+ *
+ * The outputs are the window means of in·sin and in·cos, as X and Y of
+ * @ref LockIn::LockIn_runIQ: a sine of amplitude A at the bin frequency
+ * gives R = A / 2 if the window holds whole periods of it.
+ *
+ * @tparam Bins      Number of frequency bins.
+ * @tparam MaxLength Maximum window length, sizes the input buffer.
+ */
+template <std::size_t Bins, std::size_t MaxLength = FIR_MAX_LENGTH>
+class SlidingDft
+{
+    static_assert(Bins > 0 && MaxLength > 0, "Sliding DFT needs at least one bin and one sample!");
+
+  public:
+    /**
+     * @param LUT       Sine table of the references, e.g. of the DDS.
+     * @param fullScale Largest input magnitude, larger products saturate.
+     * @param length    Window length, see @ref SetLength.
+     */
+    SlidingDft(const SinusLUT<>& LUT, float fullScale, std::size_t length = MaxLength)
+      : _LUT(LUT), _fullScale(fullScale), _inputScale((float)(2147483647.0 / (double)fullScale))
+    {
+        SetLength(length);
+    }
+
+    /**
+     * @brief Phase word step of a bin at @p freq [Hz], full scale = CtrlFreq.
+     */
+    static uint32_t PhaseStep(float freq)
+    {
+        return (uint32_t)(int64_t)std::llround((double)freq / (double)CtrlFreq * 4294967296.0);
+    }
+
+    /**
+     * @brief Sets the window length, limited to [1, MaxLength], and clears
+     * the input buffer and all bins.
+     */
+    void SetLength(std::size_t length)
+    {
+        _length = (length < 1) ? 1 : (length > MaxLength) ? MaxLength : length;
+        _scale  = (float)((double)_fullScale / 2147483647.0 / (double)_length);
+        _buffer.fill(0.0f);
+        _index = 0;
+        for (std::size_t k = 0; k < Bins; k++) {
+            m_rebuild(k);
+        }
+    }
+
+    std::size_t Length() const
+    {
+        return _length;
+    }
+
+    void SetBin(std::size_t index, float freq)
+    {
+        SetBinStep(index, PhaseStep(freq));
+    }
+
+    /**
+     * @brief Sets the phase word step of bin @p index, e.g. n times the
+     * phase step of a DDS for its n-th harmonic.
+     *
+     * The sums of the bin are recomputed from the buffered input, so its
+     * output is valid right away.  Not to be called concurrently with
+     * @ref Calc.
+     */
+    void SetBinStep(std::size_t index, uint32_t step)
+    {
+        _step[index] = step;
+        m_rebuild(index);
+    }
+
+    uint32_t BinStep(std::size_t index) const
+    {
+        return _step[index];
+    }
+
+    /**
+     * @brief Slides the window of all bins by the sample @p input.
+     */
+    void Calc(float input)
+    {
+        const float oldest = _buffer[_index];
+        _buffer[_index]    = input;
+        _index             = (_index + 1 < _length) ? _index + 1 : 0;
+
+        for (std::size_t k = 0; k < Bins; k++) {
+            const uint32_t phase = _phase[k] + _step[k];
+            _phase[k]            = phase;
+
+            float sin, cos, sinOldest, cosOldest;
+            _LUT.InterpIQ(phase, sin, cos);
+            _LUT.InterpIQ(phase - _windowStep[k], sinOldest, cosOldest);
+
+            _sumI[k] += m_quantize(input * sin) - m_quantize(oldest * sinOldest);
+            _sumQ[k] += m_quantize(input * cos) - m_quantize(oldest * cosOldest);
+        }
+    }
+
+    /**
+     * @brief Returns X, Y, R and θ of bin @p index.
+     *
+     * R and θ are calculated here, not in @ref Calc, so the ISR only pays
+     * for the outputs actually read.
+     */
+    LockInIQ Output(std::size_t index) const
+    {
+        LockInIQ out;
+        out.x     = (float)_sumI[index] * _scale;
+        out.y     = (float)_sumQ[index] * _scale;
+        out.r     = fast_math::sqrt(out.x * out.x + out.y * out.y);
+        out.theta = fast_math::atan2(out.y, out.x);
+        return out;
+    }
+
+  private:
+    using sums_t = std::array<int64_t, Bins>;
+
+    int64_t m_quantize(float product) const
+    {
+        const float scaled = std::max(-2147483520.0f, std::min(product * _inputScale, 2147483520.0f));
+        return (int64_t)(int32_t)scaled;
+    }
+
+    // sums of bin k over the buffered input, oldest first, with the same
+    // products Calc subtracts when the samples leave the window
+    void m_rebuild(std::size_t k)
+    {
+        _windowStep[k] = _step[k] * (uint32_t)_length;
+        _sumI[k]       = 0;
+        _sumQ[k]       = 0;
+        for (std::size_t age = _length; age-- > 0;) {
+            const float    input = _buffer[(_index + _length - 1 - age) % _length];
+            const uint32_t phase = _phase[k] - _step[k] * (uint32_t)age;
+            float          sin, cos;
+            _LUT.InterpIQ(phase, sin, cos);
+            _sumI[k] += m_quantize(input * sin);
+            _sumQ[k] += m_quantize(input * cos);
+        }
+    }
+
+    const SinusLUT<>&            _LUT;
+    float                        _fullScale;
+    float                        _inputScale;
+    std::array<float, MaxLength> _buffer{};
+    std::size_t                  _length = MaxLength;
+    std::size_t                  _index  = 0;
+    float                        _scale  = 1.0f;
+
+    std::array<uint32_t, Bins> _step{};
+    std::array<uint32_t, Bins> _windowStep{};
+    std::array<uint32_t, Bins> _phase{};
+    sums_t                     _sumI{};
+    sums_t                     _sumQ{};
+};
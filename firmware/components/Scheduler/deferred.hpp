@@ -0,0 +1,65 @@
+#pragma once
+#include "tripleBuffer.hpp"
+
+/**
+ * @brief Work deferred from a high-priority interrupt to a lower-priority
+ * one.
+ *
+ * The high-priority side @ref Post "posts" its input through a
+ * @ref TripleBuffer and pends the low-priority interrupt with @p Trigger;
+ * the handler of that interrupt calls @ref Run, which runs the work on the
+ * latest posted input.  Posting costs one copy and one atomic exchange, so
+ * the high-priority side does not depend on how long the work takes, and
+ * the work may be preempted anywhere.  An input posted while the previous
+ * one is still pending replaces it, see @ref Dropped.
+ *
+ * @tparam T       Input of the deferred work.
+ * @tparam Trigger `static void Pend()`, pends the low-priority interrupt,
+ *                 e.g. by setting PendSV.
+ */
+template <class T, class Trigger>
+class Deferred
+{
+  public:
+    /**
+     * @brief High-priority side: hands over @p input and pends the work.
+     */
+    void Post(const T& input)
+    {
+        _buffer.Publish(input);
+        _posted++;
+        Trigger::Pend();
+    }
+
+    /**
+     * @brief Low-priority side: runs @p work on the latest posted input, if
+     * there is a new one.
+     *
+     * @param work `void(const T&)`.
+     * @return true if @p work ran.
+     */
+    template <class Work>
+    bool Run(Work&& work)
+    {
+        if (!_buffer.Consume()) {
+            return false;
+        }
+        _runs++;
+        work(_buffer.Read());
+        return true;
+    }
+
+    /**
+     * @brief Inputs replaced before they were run, i.e. the low-priority
+     * work did not keep up.  Approximate while posts are in flight.
+     */
+    uint32_t Dropped() const
+    {
+        return _posted - _runs;
+    }
+
+  private:
+    TripleBuffer<T> _buffer;
+    uint32_t        _posted = 0; // high-priority side
+    uint32_t        _runs   = 0; // low-priority side
+};
@@ -0,0 +1,56 @@
+#pragma once
+#include "tripleBuffer.hpp"
+
+/**
+ * @brief Lock-free mailbox for whole parameter sets, from the main context
+ * to an interrupt.
+ *
+ * The main context @ref Send "sends" complete sets; the interrupt calls
+ * @ref Receive at a tick boundary and applies the latest set, never a torn
+ * or partly written one.  @ref Receive costs one atomic load if nothing is
+ * new and one exchange plus the apply otherwise, with no copy of @p T; the
+ * sender never blocks the interrupt nor the other way round.  Sets sent
+ * faster than the interrupt receives them are superseded by the latest.
+ *
+ * One sender and one receiver context, see @ref TripleBuffer.
+ *
+ * @tparam T Parameter set, a copyable aggregate of plain values.
+ */
+template <class T>
+class Mailbox
+{
+  public:
+    Mailbox() = default;
+    explicit Mailbox(const T& initial)
+      : _buffer(initial)
+    {
+    }
+
+    /**
+     * @brief Sender side: replaces the pending parameter set.
+     */
+    void Send(const T& param)
+    {
+        _buffer.Publish(param);
+    }
+
+    /**
+     * @brief Receiver side: applies the latest sent set, if there is a new
+     * one.
+     *
+     * @param apply `void(const T&)`, the set is valid during the call.
+     * @return true if @p apply ran.
+     */
+    template <class Apply>
+    bool Receive(Apply&& apply)
+    {
+        if (!_buffer.Consume()) {
+            return false;
+        }
+        apply(_buffer.Read());
+        return true;
+    }
+
+  private:
+    TripleBuffer<T> _buffer;
+};
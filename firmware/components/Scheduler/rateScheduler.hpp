@@ -0,0 +1,173 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+
+/**
+ * @brief Rate group of a scheduled task: it runs on the ticks t with
+ * t % divisor == phase, i.e. at the tick rate divided by @ref divisor.
+ */
+struct RateGroup
+{
+    uint32_t divisor; // integer divisor of the tick rate, at least 1
+    uint32_t phase;   // tick within the period, below the divisor
+    uint32_t budget;  // cycles per run, 0 for no budget
+};
+
+/**
+ * @brief Run time of a scheduled task in cycles of the scheduler clock.
+ */
+struct TaskStats
+{
+    uint32_t runs       = 0;
+    uint32_t lastCycles = 0;
+    uint32_t maxCycles  = 0;
+    uint32_t overruns   = 0; // runs over budget
+};
+
+namespace scheduler_detail {
+constexpr uint32_t gcd(uint32_t a, uint32_t b)
+{
+    while (b != 0) {
+        const uint32_t rest = a % b;
+        a                   = b;
+        b                   = rest;
+    }
+    return a;
+}
+} // namespace scheduler_detail
+
+/**
+ * @brief Checks a rate group table: every divisor at least 1, every phase
+ * below its divisor, and no two slow groups (divisor > 1) on the same tick.
+ *
+ * Two groups of divisors a and b meet on some tick exactly if their phases
+ * are congruent modulo gcd(a, b).  Groups of divisor 1 run on every tick
+ * and are exempt.  Meant for `static_assert` on constant tables.
+ */
+template <std::size_t N>
+constexpr bool RateGroupsValid(const std::array<RateGroup, N>& groups)
+{
+    for (std::size_t i = 0; i < N; i++) {
+        if (groups[i].divisor < 1 || groups[i].phase >= groups[i].divisor) {
+            return false;
+        }
+        for (std::size_t j = 0; j < i; j++) {
+            if (groups[i].divisor == 1 || groups[j].divisor == 1) {
+                continue;
+            }
+            const uint32_t common = scheduler_detail::gcd(groups[i].divisor, groups[j].divisor);
+            if (groups[i].phase % common == groups[j].phase % common) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Static multi-rate scheduler, ticked by the control timer.
+ *
+ * Each task is a callable with a @ref RateGroup: on every @ref Tick the due
+ * tasks run in table order, so a task of divisor 1 listed first (the fast
+ * path) always precedes the slow tasks of the same tick.  The slow tasks
+ * are spread over the ticks by their phases; @ref RateGroupsValid checks
+ * that no two of them share a tick.  Every run is timed with @p Clock
+ * (`static uint32_t Now()`, a free-running cycle counter) against the
+ * budget of its group, see @ref Stats.
+ *
+ * The tasks are held by value and dispatched without function pointers,
+ * so they inline into @ref Tick.  Construct with @ref MakeRateScheduler.
+ *
+ * @tparam Clock Cycle counter.
+ * @tparam Tasks Task callables, `void operator()()`.
+ */
+template <class Clock, class... Tasks>
+class RateScheduler
+{
+  public:
+    static constexpr std::size_t tasks = sizeof...(Tasks);
+    using groups_t                     = std::array<RateGroup, tasks>;
+
+    RateScheduler(const groups_t& groups, Tasks... task)
+      : _groups(groups), _tasks(std::move(task)...)
+    {
+        for (std::size_t k = 0; k < tasks; k++) {
+            const uint32_t divisor = (_groups[k].divisor < 1) ? 1 : _groups[k].divisor;
+            _groups[k].divisor     = divisor;
+            _groups[k].phase       = _groups[k].phase % divisor;
+            _countdown[k]          = _groups[k].phase;
+        }
+    }
+
+    /**
+     * @brief Runs the tasks due on this tick, called once per timer period.
+     */
+    void Tick()
+    {
+        m_tick(std::index_sequence_for<Tasks...>{});
+    }
+
+    const RateGroup& Group(std::size_t task) const
+    {
+        return _groups[task];
+    }
+
+    const TaskStats& Stats(std::size_t task) const
+    {
+        return _stats[task];
+    }
+
+    void ResetStats()
+    {
+        _stats.fill(TaskStats{});
+    }
+
+  private:
+    template <std::size_t... Task>
+    void m_tick(std::index_sequence<Task...>)
+    {
+        (m_run<Task>(), ...);
+    }
+
+    // a countdown per task instead of tick % divisor: no division, and no
+    // phase jump when a tick counter would wrap
+    template <std::size_t Task>
+    void m_run()
+    {
+        if (_countdown[Task] != 0) {
+            _countdown[Task]--;
+            return;
+        }
+        _countdown[Task] = _groups[Task].divisor - 1;
+
+        const uint32_t start = Clock::Now();
+        std::get<Task>(_tasks)();
+        const uint32_t cycles = Clock::Now() - start;
+
+        auto& stats      = _stats[Task];
+        stats.runs       = stats.runs + 1;
+        stats.lastCycles = cycles;
+        stats.maxCycles  = (cycles > stats.maxCycles) ? cycles : stats.maxCycles;
+        if (_groups[Task].budget != 0 && cycles > _groups[Task].budget) {
+            stats.overruns = stats.overruns + 1;
+        }
+    }
+
+    groups_t                     _groups;
+    std::tuple<Tasks...>         _tasks;
+    std::array<uint32_t, tasks>  _countdown{};
+    std::array<TaskStats, tasks> _stats{};
+};
+
+/**
+ * @brief Builds a @ref RateScheduler of the given tasks, e.g. lambdas, with
+ * their rate groups in the same order.
+ */
+template <class Clock, class... Tasks>
+RateScheduler<Clock, Tasks...> MakeRateScheduler(const std::array<RateGroup, sizeof...(Tasks)>& groups, Tasks... tasks)
+{
+    return RateScheduler<Clock, Tasks...>(groups, std::move(tasks)...);
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Lock-free single-producer/single-consumer handoff of the latest
+ * value of @p T.
+ *
+ * Three slots: the producer owns one to write into, the consumer one to
+ * read from, and the third is exchanged between them together with a flag
+ * for a new value.  @ref Publish and @ref Consume are each one atomic
+ * exchange plus a copy of @p T, so both sides have constant cost and never
+ * wait for each other, regardless of which one preempts the other.  Values
+ * published between two @ref Consume calls are overwritten, the consumer
+ * gets the latest.
+ *
+ * Producer side: @ref Write, @ref Publish.  Consumer side: @ref Consume,
+ * @ref Read.  Each side must stay in one context.
+ *
+ * @tparam T Copyable value type.
+ */
+template <class T>
+class TripleBuffer
+{
+  public:
+    TripleBuffer() = default;
+    explicit TripleBuffer(const T& initial)
+    {
+        _slots.fill(initial);
+    }
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /**
+     * @brief Slot of the producer, to be filled before @ref Publish.
+     */
+    T& Write()
+    {
+        return _slots[_write];
+    }
+
+    /**
+     * @brief Hands the written slot to the consumer.
+     */
+    void Publish()
+    {
+        _write = _shared.exchange((uint8_t)(_write | NEW), std::memory_order_acq_rel) & INDEX;
+    }
+
+    void Publish(const T& value)
+    {
+        Write() = value;
+        Publish();
+    }
+
+    /**
+     * @brief Takes the latest published value, if there is a new one.
+     *
+     * @return true if @ref Read changed.
+     */
+    bool Consume()
+    {
+        if ((_shared.load(std::memory_order_relaxed) & NEW) == 0) {
+            return false;
+        }
+        _read = _shared.exchange(_read, std::memory_order_acq_rel) & INDEX;
+        return true;
+    }
+
+    /**
+     * @brief Slot of the consumer, the value of the last successful
+     * @ref Consume.
+     */
+    const T& Read() const
+    {
+        return _slots[_read];
+    }
+
+  private:
+    static constexpr uint8_t INDEX = 0x03;
+    static constexpr uint8_t NEW   = 0x04;
+
+    std::array<T, 3>     _slots{};
+    uint8_t              _write = 0; // producer
+    uint8_t              _read  = 1; // consumer
+    std::atomic<uint8_t> _shared{2};
+};
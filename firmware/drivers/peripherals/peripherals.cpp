@@ -14,8 +14,14 @@ void peripheral_initialization()
     LD_CHN1.init();
     DAC_CHN1_FAST.init();
     DAC_SLOW.init();
+    // the slow loop is preempted by the control loop, TIM2 at priority 0
+    HAL_NVIC_SetPriority(PendSV_IRQn, 15, 0);
     HAL_TIM_Base_Start_IT(&htim2);
 }
+void SlowLoopTrigger::Pend()
+{
+    SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+}
 std::array<uint32_t, LDCHNs> read_LD_signals()
 {
 
@@ -31,6 +37,16 @@ std::array<uint32_t, LDCHNs> read_LD_signals()
 // }
 void transmit_DAC_values(uint16_t dacvalues[2], CHN_Param& chn_param)
 {
-    chn_param.DAC_FAST_CHN.transmit(dacvalues[0]); //  transmit adc value for debugging purpose
-    DAC_SLOW.transmit(dacvalues[1], chn_param.SLOW_CHN_NO);
+    transmit_fast_DAC_value(dacvalues[0], chn_param);
+    transmit_slow_DAC_value(dacvalues[1], chn_param);
+}
+// fast and slow DAC are on separate SPIs, so the control and the slow-loop
+// interrupt can each write theirs
+void transmit_fast_DAC_value(uint16_t dacvalue, CHN_Param& chn_param)
+{
+    chn_param.DAC_FAST_CHN.transmit(dacvalue); //  transmit adc value for debugging purpose
+}
+void transmit_slow_DAC_value(uint16_t dacvalue, CHN_Param& chn_param)
+{
+    DAC_SLOW.transmit(dacvalue, chn_param.SLOW_CHN_NO);
 }
\ No newline at end of file
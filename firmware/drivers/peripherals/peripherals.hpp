@@ -24,12 +24,24 @@ const uint32_t MainFreq      = 200e6;                   // µC main frequency [H
 const uint16_t Tim2PSC       = 0;                       // TIM prescaler
 const uint32_t CtrlFreq      = 100e3;                   // loop frequency [Hz]
 const uint32_t Tim2ARR       = MainFreq / CtrlFreq - 1; // TIM ARR
+const float    PDMaxVolt     = 2.45f;                   // photodiode signal at ADC full scale [V]
 const uint8_t  DAC_SLOW_CHN1 = 0;
 SPI            DAC_CHN1_FAST{SPI2}; // dac fast output channel 1
 SPI            DAC_SLOW{SPI5};      // dac slow output
 ADC            LD_CHN1{INPUT_ADC};  // Laser diode signal channel 1
 } // namespace
 
+/**
+ * @brief Pends the slow-loop interrupt, PendSV.  It runs at the lowest
+ * priority, below the TIM2 control interrupt, once that has returned.
+ */
+struct SlowLoopTrigger
+{
+    static void Pend();
+};
+
 void                         peripheral_initialization();
 std::array<uint32_t, LDCHNs> read_LD_signals();
 void                         transmit_DAC_values(uint16_t dacvalue[2], CHN_Param& chn_param);
+void                         transmit_fast_DAC_value(uint16_t dacvalue, CHN_Param& chn_param);
+void                         transmit_slow_DAC_value(uint16_t dacvalue, CHN_Param& chn_param);
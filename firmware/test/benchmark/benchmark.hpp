@@ -0,0 +1,157 @@
+/**
+ * @file benchmark.hpp
+ * @brief Helpers for the host benchmarks: timing and spectral analysis.
+ * @copyright (c) 2021 TOPTICA Photonics AG
+ */
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace benchmark {
+
+/**
+ * @brief Prevents the compiler from optimizing away a benchmarked value.
+ */
+template <typename T>
+inline void keep(const T& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * @brief Measures the run time of @p function in nanoseconds per sample.
+ *
+ * @param function Callable processing @p samples samples per call.
+ * @param samples  Number of samples processed per call.
+ * @param repeat   Number of calls, the fastest one is reported.
+ */
+template <typename F>
+double ns_per_sample(F&& function, std::size_t samples, int repeat = 5)
+{
+    double best = 1e300;
+    for (int r = 0; r < repeat; r++) {
+        const auto start = std::chrono::steady_clock::now();
+        function();
+        const auto stop = std::chrono::steady_clock::now();
+        best            = std::min(best, std::chrono::duration<double, std::nano>(stop - start).count());
+    }
+    return best / (double)samples;
+}
+
+/**
+ * @brief Measures the run time of @p function in time stamp counter cycles
+ * per sample, see @ref ns_per_sample.  Only on x86 hosts, elsewhere 0.
+ */
+template <typename F>
+double cycles_per_sample(F&& function, std::size_t samples, int repeat = 5)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned long long best = ~0ull;
+    for (int r = 0; r < repeat; r++) {
+        const auto start = __rdtsc();
+        function();
+        best = std::min(best, __rdtsc() - start);
+    }
+    return (double)best / (double)samples;
+#else
+    (void)function;
+    (void)samples;
+    (void)repeat;
+    return 0.0;
+#endif
+}
+
+/**
+ * @brief In-place iterative radix-2 FFT, the size must be a power of two.
+ */
+inline void fft(std::vector<std::complex<double>>& x)
+{
+    const std::size_t n = x.size();
+    for (std::size_t i = 1, j = 0; i < n; i++) {
+        std::size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            std::swap(x[i], x[j]);
+        }
+    }
+    for (std::size_t len = 2; len <= n; len <<= 1) {
+        const double               angle = -2.0 * M_PI / (double)len;
+        const std::complex<double> w{std::cos(angle), std::sin(angle)};
+        for (std::size_t i = 0; i < n; i += len) {
+            std::complex<double> wk{1.0, 0.0};
+            for (std::size_t k = 0; k < len / 2; k++) {
+                const auto u         = x[i + k];
+                const auto v         = x[i + k + len / 2] * wk;
+                x[i + k]             = u + v;
+                x[i + k + len / 2] = u - v;
+                wk *= w;
+            }
+        }
+    }
+}
+
+struct spectrum_metrics
+{
+    double      sfdr_db;        // carrier to worst spur [dB]
+    double      thd_db;         // harmonics 2..10 to carrier [dB]
+    double      worst_spur_dbc; // worst spur relative to the carrier [dBc]
+    std::size_t worst_spur_bin; // FFT bin of the worst spur
+};
+
+/**
+ * @brief Spectral purity of a coherently sampled tone.
+ *
+ * The tone must complete exactly @p carrier_bin periods within the signal,
+ * which must have a power of two length.  No window is applied, so the
+ * carrier occupies a single bin and every other bin (except DC) is a spur.
+ */
+inline spectrum_metrics analyze(const std::vector<float>& signal, std::size_t carrier_bin)
+{
+    std::vector<std::complex<double>> x(signal.begin(), signal.end());
+    fft(x);
+
+    const std::size_t   n = x.size();
+    std::vector<double> power(n / 2);
+    for (std::size_t k = 0; k < n / 2; k++) {
+        power[k] = std::norm(x[k]) + 1e-30;
+    }
+
+    const double carrier = power[carrier_bin];
+    std::size_t  worst   = 1;
+    for (std::size_t k = 1; k < n / 2; k++) {
+        if (k != carrier_bin && power[k] > power[worst]) {
+            worst = k;
+        }
+    }
+
+    double harmonics = 1e-30;
+    for (std::size_t h = 2; h <= 10; h++) {
+        std::size_t bin = (h * carrier_bin) % n; // alias into the first Nyquist zone
+        if (bin >= n / 2) {
+            bin = n - bin;
+        }
+        if (bin != 0 && bin != carrier_bin) {
+            harmonics += power[bin];
+        }
+    }
+
+    return {
+        10.0 * std::log10(carrier / power[worst]),
+        10.0 * std::log10(harmonics / carrier),
+        10.0 * std::log10(power[worst] / carrier),
+        worst};
+}
+
+} // namespace benchmark
@@ -0,0 +1,84 @@
+/**
+ * @file benchmark_channels.cpp
+ * @brief Run time of the channel engine over the number of channels, against
+ *        a single-channel engine per channel.
+ * @copyright (c) 2021 TOPTICA Photonics AG
+ */
+#include "benchmark.hpp"
+#include "channelEngine.hpp"
+#include "ctrlLoop.hpp"
+#include "sinusLUT.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+
+namespace {
+const std::size_t SAMPLES = 1 << 20;
+
+PIDParam pid_param{1.0f, 100.0f, 0.0f, 1.0f, 10.0f, 0.0f};
+DDSParam dds_param{true, 1.0f, 1.0f, 20000.0f, 0.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT};
+
+void print(const char* name, std::size_t channels, double cycles, double single)
+{
+    std::printf("%-16s %8zu %12.1f %12.2f\n", name, channels, cycles, cycles / single);
+}
+
+/**
+ * @brief Cycles per tick of @p Channels separate single-channel engines.
+ */
+template <std::size_t Channels>
+double single_channel_engines()
+{
+    std::array<std::unique_ptr<ChannelEngine<1>>, Channels> engines;
+    for (auto& engine : engines) {
+        engine = std::make_unique<ChannelEngine<1>>(pid_param, dds_param, 2000.0f);
+    }
+    return benchmark::cycles_per_sample(
+        [&] {
+            float sum = 0;
+            for (std::size_t n = 0; n < SAMPLES; n++) {
+                for (auto& engine : engines) {
+                    std::array<float, 1> error{(float)(n & 0xff) * 1e-3f}, sctrl, fctrl;
+                    engine->step(error, sctrl, fctrl);
+                    sum += fctrl[0];
+                }
+            }
+            benchmark::keep(sum);
+        },
+        SAMPLES);
+}
+
+/**
+ * @brief Cycles per tick of a ChannelEngine with @p Channels channels.
+ */
+template <std::size_t Channels>
+double channel_engine()
+{
+    ChannelEngine<Channels> engine{pid_param, dds_param, 2000.0f};
+    return benchmark::cycles_per_sample(
+        [&] {
+            float sum = 0;
+            for (std::size_t n = 0; n < SAMPLES; n++) {
+                std::array<float, Channels> error, sctrl, fctrl;
+                error.fill((float)(n & 0xff) * 1e-3f);
+                engine.step(error, sctrl, fctrl);
+                sum += fctrl[0];
+            }
+            benchmark::keep(sum);
+        },
+        SAMPLES);
+}
+} // namespace
+
+int main()
+{
+    std::printf("%-16s %8s %12s %12s\n", "", "channels", "cyc/tick", "x 1 channel");
+    const double engine = channel_engine<1>();
+    print("ChannelEngine", 1, engine, engine);
+    print("ChannelEngine", 2, channel_engine<2>(), engine);
+    print("ChannelEngine", 3, channel_engine<3>(), engine);
+    print("ChannelEngine<1>", 3, single_channel_engines<3>(), engine);
+    return 0;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file benchmark_dds.cpp
+ * @brief Run time of the DDS block generation versus per-sample calls, and of sweeps.
+ * @copyright (c) 2021 TOPTICA Photonics AG
+ */
+#include "benchmark.hpp"
+#include "dds.hpp"
+#include "sinusLUT.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace {
+const uint32_t    CtrlFreq = 100e3;
+const std::size_t SAMPLES  = 1 << 22;
+} // namespace
+
+int main()
+{
+    DDSParam param{true, 1.0f, 1.0f, 20000.0f, 10.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT};
+
+    std::printf("%-24s %10s\n", "DDS", "ns/sample");
+
+    {
+        DDS        dds{param};
+        const auto ns = benchmark::ns_per_sample(
+            [&] {
+                float sum = 0;
+                for (std::size_t k = 0; k < SAMPLES; k++) {
+                    float out, shift_out;
+                    dds.Calc(out, shift_out);
+                    sum += shift_out;
+                }
+                benchmark::keep(sum);
+            },
+            SAMPLES);
+        std::printf("%-24s %10.2f\n", "Calc", ns);
+    }
+    {
+        DDS      dds{param};
+        DDSSweep sweep{{1000.0f, 40000.0f, 100000, SweepShape::logarithmic, SweepMode::triangle, CtrlFreq}};
+        dds.StartSweep(sweep);
+        const auto ns = benchmark::ns_per_sample(
+            [&] {
+                float sum = 0;
+                for (std::size_t k = 0; k < SAMPLES; k++) {
+                    float out, shift_out;
+                    dds.Calc(out, shift_out);
+                    sum += shift_out;
+                }
+                benchmark::keep(sum);
+            },
+            SAMPLES);
+        std::printf("%-24s %10.2f\n", "Calc (sweep)", ns);
+    }
+    {
+        DDS        dds{param};
+        const auto ns = benchmark::ns_per_sample(
+            [&] {
+                float sum = 0;
+                for (std::size_t k = 0; k < SAMPLES; k++) {
+                    float i_out, q_out;
+                    dds.CalcIQ(i_out, q_out);
+                    sum += i_out + q_out;
+                }
+                benchmark::keep(sum);
+            },
+            SAMPLES);
+        std::printf("%-24s %10.2f\n", "CalcIQ", ns);
+    }
+    for (std::size_t block : {16, 64, 256}) {
+        DDS                dds{param};
+        std::vector<float> out(block);
+        const auto         ns = benchmark::ns_per_sample(
+            [&] {
+                for (std::size_t k = 0; k < SAMPLES; k += block) {
+                    dds.CalcBlock(out.data(), block);
+                    benchmark::keep(out[0]);
+                }
+            },
+            SAMPLES);
+        std::printf("CalcBlock(%3zu)           %10.2f\n", block, ns);
+    }
+    for (std::size_t block : {16, 64, 256}) {
+        DDS                dds{param};
+        std::vector<float> i_out(block), q_out(block);
+        const auto         ns = benchmark::ns_per_sample(
+            [&] {
+                for (std::size_t k = 0; k < SAMPLES; k += block) {
+                    dds.CalcIQBlock(i_out.data(), q_out.data(), block);
+                    benchmark::keep(i_out[0]);
+                    benchmark::keep(q_out[0]);
+                }
+            },
+            SAMPLES);
+        std::printf("CalcIQBlock(%3zu)         %10.2f\n", block, ns);
+    }
+    return 0;
+}
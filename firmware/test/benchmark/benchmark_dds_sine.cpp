@@ -0,0 +1,113 @@
+/**
+ * @file benchmark_dds_sine.cpp
+ * @brief Spectral purity, run time and table size of the DDS sine generation
+ *        policies.
+ * @copyright (c) 2021 TOPTICA Photonics AG
+ */
+#include "benchmark.hpp"
+#include "dds.hpp"
+#include "sinePolicy.hpp"
+#include "sinusLUT.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace {
+const uint32_t    CtrlFreq      = 100e3;
+const int         AW            = 16;
+const std::size_t N             = 1 << AW; // FFT length, one full phase cycle
+const uint32_t    TW            = 13107;   // odd tuning word near fclk / 5
+const std::size_t TIMED_SAMPLES = 1 << 22;
+
+template <class Sine>
+void measure(const char* name, std::size_t table_bytes)
+{
+    const float freq = (float)TW * (float)CtrlFreq / (float)(1u << AW);
+    DDSParam    param{true, 1.0f, 0.0f, freq, 30.0f, CtrlFreq, AW, SinusLUT<>::bits, sinusLUT};
+
+    BasicDDS<Sine>     dds{param};
+    std::vector<float> out(N), shift_out(N);
+    for (std::size_t n = 0; n < N; n++) {
+        dds.Calc(out[n], shift_out[n]);
+    }
+    const auto metrics       = benchmark::analyze(out, TW);
+    const auto metrics_shift = benchmark::analyze(shift_out, TW);
+
+    auto run = [&] {
+        float sum = 0;
+        for (std::size_t k = 0; k < TIMED_SAMPLES; k++) {
+            float o, s;
+            dds.Calc(o, s);
+            sum += o + s;
+        }
+        benchmark::keep(sum);
+    };
+    const auto ns     = benchmark::ns_per_sample(run, TIMED_SAMPLES);
+    const auto cycles = benchmark::cycles_per_sample(run, TIMED_SAMPLES);
+
+    std::printf(
+        "%-10s %10.1f %10.1f %10.1f %10.2f %10.1f %8zu\n",
+        name,
+        metrics.sfdr_db,
+        metrics_shift.sfdr_db,
+        metrics.thd_db,
+        ns,
+        cycles,
+        table_bytes);
+}
+
+/**
+ * Run time of a policy while every sample changes the phase step (a linear
+ * sweep), i.e. the retune path; for the resonator this is a resync with two
+ * CORDIC rotations per sample.
+ */
+template <class Sine>
+void measure_retune(const char* name)
+{
+    DDSParam       param{true, 1.0f, 0.0f, 1000.0f, 30.0f, CtrlFreq, AW, SinusLUT<>::bits, sinusLUT};
+    DDSSweep       sweep{{1000.0f, 20000.0f, TIMED_SAMPLES, SweepShape::linear, SweepMode::triangle, CtrlFreq}};
+    BasicDDS<Sine> dds{param};
+    dds.StartSweep(sweep);
+
+    auto run = [&] {
+        float sum = 0;
+        for (std::size_t k = 0; k < TIMED_SAMPLES; k++) {
+            float o, s;
+            dds.Calc(o, s);
+            sum += o + s;
+        }
+        benchmark::keep(sum);
+    };
+    std::printf(
+        "%-10s %10.2f %10.1f\n",
+        name,
+        benchmark::ns_per_sample(run, TIMED_SAMPLES),
+        benchmark::cycles_per_sample(run, TIMED_SAMPLES));
+}
+} // namespace
+
+int main()
+{
+    std::printf(
+        "%-10s %10s %10s %10s %10s %10s %8s\n",
+        "policy",
+        "SFDR[dB]",
+        "shift[dB]",
+        "THD[dB]",
+        "ns/sample",
+        "cyc/sample",
+        "table[B]");
+    measure<LUTSine>("LUT", sizeof(SinusLUT<>));
+    measure<BasicLUTSine<256>>("LUT 256", sizeof(SinusLUT<256>));
+    measure<CordicSine>("CORDIC", sizeof(int32_t) * CordicSine::iterations);
+    measure<ResonatorSine>("resonator", sizeof(int32_t) * CordicSine::iterations);
+
+    // the resonator resyncs on every phase step change and every RESYNC
+    // samples: the cost of a retune, amortized over the fixed tone above
+    std::printf("\nretuned every sample (sweep)\n%-10s %10s %10s\n", "policy", "ns/sample", "cyc/sample");
+    measure_retune<LUTSine>("LUT");
+    measure_retune<CordicSine>("CORDIC");
+    measure_retune<ResonatorSine>("resonator");
+    return 0;
+}
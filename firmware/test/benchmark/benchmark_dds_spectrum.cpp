@@ -0,0 +1,192 @@
+/**
+ * @file benchmark_dds_spectrum.cpp
+ * @brief Spectral purity and run time of the DDS over accumulator width, LUT
+ *        grid width and interpolation mode.
+ *
+ * Without arguments, prints SFDR, THD, worst spur and ns/sample for every
+ * combination.  With `--check`, runs the DDS with the shipped sine table for
+ * every accumulator width and fails if its spectral purity is below the
+ * limits below (registered as ctest test).
+ * @copyright (c) 2021 TOPTICA Photonics AG
+ */
+#include "benchmark.hpp"
+#include "dds.hpp"
+#include "sinusLUT.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+const uint32_t    CtrlFreq      = 100e3;
+const int         FFT_BITS      = 20;
+const std::size_t N             = 1 << FFT_BITS;
+const std::size_t TIMED_SAMPLES = 1 << 22;
+
+const int ACCUMULATOR_WIDTHS[] = {12, 14, 16, 18, 20}; // up to FFT_BITS, see tuning_word()
+
+// Spectral purity limits of the shipped sine table with interpolation, per
+// accumulator width, about 3 dB below the measured values.
+struct limit
+{
+    int    accumulatorWidth;
+    double min_sfdr_db;
+    double max_thd_db;
+};
+const limit LIMITS[] = {
+    {12, 168.0, -170.0},
+    {14, 139.0, -170.0},
+    {16, 141.0, -170.0},
+    {18, 141.0, -170.0},
+    {20, 141.0, -170.0},
+};
+
+enum class Interpolation
+{
+    none,
+    linear,
+};
+
+/**
+ * @brief Tuning word of a tone near fclk / 5.  It is odd, so the phase runs
+ * through all 2^AW values and the tone is coherent within the FFT for
+ * AW <= FFT_BITS.
+ */
+uint32_t tuning_word(int accumulatorWidth)
+{
+    return (uint32_t)std::lround(0.2 * (double)(1u << accumulatorWidth)) | 1u;
+}
+
+std::size_t carrier_bin(int accumulatorWidth)
+{
+    return tuning_word(accumulatorWidth) << (FFT_BITS - accumulatorWidth);
+}
+
+template <Interpolation Interp, class LUT>
+float sample(const LUT& lut, uint32_t phase)
+{
+    if constexpr (Interp == Interpolation::linear) {
+        return lut.Interp(phase);
+    } else {
+        return lut.Lookup(phase);
+    }
+}
+
+/**
+ * @brief Runs the phase accumulator of DDS::Calc with the given table and
+ * interpolation and prints one result line.
+ */
+template <std::size_t Length, Interpolation Interp>
+void measure(int accumulatorWidth)
+{
+    static constexpr SinusLUT<Length> lut{};
+
+    const uint32_t step = tuning_word(accumulatorWidth) << (32 - accumulatorWidth);
+
+    std::vector<float> signal(N);
+    uint32_t           phase = 0;
+    for (auto& s : signal) {
+        phase += step;
+        s = sample<Interp>(lut, phase);
+    }
+    const auto metrics = benchmark::analyze(signal, carrier_bin(accumulatorWidth));
+
+    const auto ns = benchmark::ns_per_sample(
+        [&] {
+            float    sum = 0;
+            uint32_t p   = 0;
+            for (std::size_t k = 0; k < TIMED_SAMPLES; k++) {
+                p += step;
+                sum += sample<Interp>(lut, p);
+            }
+            benchmark::keep(sum);
+        },
+        TIMED_SAMPLES);
+
+    std::printf(
+        "%4d %6d %-8s %10.1f %10.1f %10.1f %10zu %10.2f\n",
+        accumulatorWidth,
+        SinusLUT<Length>::bits,
+        (Interp == Interpolation::linear) ? "linear" : "none",
+        metrics.sfdr_db,
+        metrics.thd_db,
+        metrics.worst_spur_dbc,
+        metrics.worst_spur_bin,
+        ns);
+}
+
+template <std::size_t Length>
+void measure_all()
+{
+    for (int accumulatorWidth : ACCUMULATOR_WIDTHS) {
+        measure<Length, Interpolation::none>(accumulatorWidth);
+        measure<Length, Interpolation::linear>(accumulatorWidth);
+    }
+}
+
+/**
+ * @brief Runs the DDS with the shipped table and checks it against the
+ * spectral purity limits and against the accumulator model used by
+ * @ref measure.
+ */
+bool check()
+{
+    bool passed = true;
+    for (const auto& l : LIMITS) {
+        const float freq = (float)tuning_word(l.accumulatorWidth) * (float)CtrlFreq
+                           / (float)(1u << l.accumulatorWidth);
+        DDSParam param{true, 1.0f, 0.0f, freq, 0.0f, CtrlFreq, l.accumulatorWidth, SinusLUT<>::bits, sinusLUT};
+        DDS      dds{param};
+
+        const uint32_t     step  = tuning_word(l.accumulatorWidth) << (32 - l.accumulatorWidth);
+        uint32_t           phase = 0;
+        bool               model = true;
+        std::vector<float> signal(N);
+        for (auto& s : signal) {
+            float shift_out;
+            dds.Calc(s, shift_out);
+            phase += step;
+            const float expected = sinusLUT.Interp(phase);
+            model                = model && std::memcmp(&s, &expected, sizeof(float)) == 0;
+        }
+        const auto metrics = benchmark::analyze(signal, carrier_bin(l.accumulatorWidth));
+        const bool ok      = model && metrics.sfdr_db >= l.min_sfdr_db && metrics.thd_db <= l.max_thd_db;
+
+        std::printf(
+            "AW %2d: SFDR %6.1f dB (min. %6.1f), THD %6.1f dB (max. %6.1f), model %s: %s\n",
+            l.accumulatorWidth,
+            metrics.sfdr_db,
+            l.min_sfdr_db,
+            metrics.thd_db,
+            l.max_thd_db,
+            model ? "matches" : "differs",
+            ok ? "ok" : "FAILED");
+        passed = passed && ok;
+    }
+    return passed;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc > 1 && std::strcmp(argv[1], "--check") == 0) {
+        return check() ? 0 : 1;
+    }
+
+    std::printf(
+        "%4s %6s %-8s %10s %10s %10s %10s %10s\n",
+        "AW",
+        "LUT",
+        "interp",
+        "SFDR[dB]",
+        "THD[dB]",
+        "spur[dBc]",
+        "spur bin",
+        "ns/sample");
+    measure_all<64>();
+    measure_all<256>();
+    measure_all<1024>();
+    measure_all<4096>();
+    return 0;
+}
@@ -0,0 +1,127 @@
+/**
+ * @file benchmark_lockin.cpp
+ * @brief Run time of the single, the dual-phase and the harmonic lock-in, of
+ *        the sliding DFT and of the fast square root and arc tangent, against
+ *        the ISR budget.
+ *
+ * The budget is one control period, 10 µs at 100 kHz, i.e. 2000 cycles of
+ * the 200 MHz target.  The host cycle counts are a lower bound for the
+ * target, which has no SIMD and a slower memory system.
+ * @copyright (c) 2021 TOPTICA Photonics AG
+ */
+#include "benchmark.hpp"
+#include "fastMath.hpp"
+#include "harmonicLockIn.hpp"
+#include "lockIn.hpp"
+#include "peripherals.hpp"
+#include "sinusLUT.hpp"
+#include "slidingDft.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace {
+const std::size_t SAMPLES       = 1 << 22;
+const double      BUDGET_CYCLES = (double)MainFreq / (double)CtrlFreq;
+
+std::vector<float> input()
+{
+    std::vector<float> in(1024);
+    for (std::size_t k = 0; k < in.size(); k++) {
+        in[k] = 30000.0f * std::sin(0.1f * (float)k) + 1000.0f;
+    }
+    return in;
+}
+
+template <typename F>
+void measure(const char* name, F&& function)
+{
+    const auto ns     = benchmark::ns_per_sample(function, SAMPLES);
+    const auto cycles = benchmark::cycles_per_sample(function, SAMPLES);
+    std::printf("%-20s %10.2f %10.1f %10.2f\n", name, ns, cycles, 100.0 * cycles / BUDGET_CYCLES);
+}
+} // namespace
+
+int main()
+{
+    DDSParam   param{true, 1.0f, 0.0f, 1000.0f, 30.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT};
+    const auto in = input();
+
+    std::printf("%-20s %10s %10s %10s\n", "", "ns/sample", "cyc/sample", "budget[%]");
+    {
+        LockIn lockIn{param, 1000.0f, 100};
+        measure("LockIn_run", [&] {
+            float sum = 0;
+            for (std::size_t k = 0; k < SAMPLES; k++) {
+                sum += lockIn.LockIn_run(in[k % in.size()]);
+            }
+            benchmark::keep(sum);
+        });
+    }
+    {
+        LockIn lockIn{param, 1000.0f, 100};
+        measure("LockIn_runIQ", [&] {
+            float sum = 0;
+            for (std::size_t k = 0; k < SAMPLES; k++) {
+                const auto out = lockIn.LockIn_runIQ(in[k % in.size()]);
+                sum += out.r + out.theta;
+            }
+            benchmark::keep(sum);
+        });
+    }
+    {
+        const uint32_t harmonics[] = {1, 2, 3};
+        HarmonicLockIn lockIn{param, 1000.0f, harmonics, 3};
+        measure("HarmonicLockIn 1-3f", [&] {
+            float sum = 0;
+            for (std::size_t k = 0; k < SAMPLES; k++) {
+                lockIn.Run(in[k % in.size()]);
+                sum += lockIn.Output(1).x;
+            }
+            benchmark::keep(sum);
+        });
+    }
+    {
+        SlidingDft<4> dft{sinusLUT, 65536.0f};
+        for (std::size_t h = 0; h < 4; h++) {
+            dft.SetBin(h, (float)(h + 1) * 1000.0f);
+        }
+        measure("SlidingDft 4 bins", [&] {
+            for (std::size_t k = 0; k < SAMPLES; k++) {
+                dft.Calc(in[k % in.size()]);
+            }
+            benchmark::keep(dft.Output(1).x);
+        });
+    }
+    measure("fast_math::sqrt", [&] {
+        float sum = 0;
+        for (std::size_t k = 0; k < SAMPLES; k++) {
+            sum += fast_math::sqrt(in[k % in.size()] + 40000.0f);
+        }
+        benchmark::keep(sum);
+    });
+    measure("std::sqrt", [&] {
+        float sum = 0;
+        for (std::size_t k = 0; k < SAMPLES; k++) {
+            sum += std::sqrt(in[k % in.size()] + 40000.0f);
+        }
+        benchmark::keep(sum);
+    });
+    measure("fast_math::atan2", [&] {
+        float sum = 0;
+        for (std::size_t k = 0; k < SAMPLES; k++) {
+            sum += fast_math::atan2(in[k % in.size()], in[(k + 16) % in.size()]);
+        }
+        benchmark::keep(sum);
+    });
+    measure("std::atan2", [&] {
+        float sum = 0;
+        for (std::size_t k = 0; k < SAMPLES; k++) {
+            sum += std::atan2(in[k % in.size()], in[(k + 16) % in.size()]);
+        }
+        benchmark::keep(sum);
+    });
+    return 0;
+}
@@ -0,0 +1,126 @@
+/**
+ * @file benchmark_polyphase.cpp
+ * @brief Run time of the polyphase decimating and interpolating FIR filters
+ *        against the naive filter-then-drop and zero-stuff-then-filter.
+ * @copyright (c) 2021 TOPTICA Photonics AG
+ */
+#include "benchmark.hpp"
+#include "fir.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+const std::size_t INPUT_SAMPLES = 1 << 20;
+
+template <std::size_t Taps>
+typename Fir<float, Taps>::coefficients_t coefficients()
+{
+    typename Fir<float, Taps>::coefficients_t h{};
+    std::mt19937                               rng{1};
+    std::uniform_real_distribution<float>      dist{-1.0f, 1.0f};
+    for (auto& c : h) {
+        c = dist(rng);
+    }
+    return h;
+}
+
+std::vector<float> input(std::size_t samples)
+{
+    std::vector<float>                    in(samples);
+    std::mt19937                          rng{2};
+    std::uniform_real_distribution<float> dist{-1.0f, 1.0f};
+    for (auto& x : in) {
+        x = dist(rng);
+    }
+    return in;
+}
+
+void print(const char* name, std::size_t taps, std::size_t factor, double naive, double polyphase)
+{
+    std::printf("%-12s %6zu %6zu %12.2f %12.2f %8.1f\n", name, taps, factor, naive, polyphase, naive / polyphase);
+}
+
+/**
+ * @brief ns per input sample of the naive and the polyphase decimator.
+ */
+template <std::size_t Taps, std::size_t Factor>
+void measure_decimator()
+{
+    const auto         h  = coefficients<Taps>();
+    const auto         in = input(INPUT_SAMPLES);
+    std::vector<float> out(INPUT_SAMPLES / Factor + 1);
+
+    Fir<float, Taps> fir{h};
+    const auto       naive = benchmark::ns_per_sample(
+        [&] {
+            std::size_t outputs = 0;
+            for (std::size_t n = 0; n < INPUT_SAMPLES; n++) {
+                const float y = fir.Calc(in[n]);
+                if (n % Factor == Factor - 1) {
+                    out[outputs++] = y;
+                }
+            }
+            benchmark::keep(out[outputs - 1]);
+        },
+        INPUT_SAMPLES);
+
+    FirDecimator<float, Taps, Factor> decimator{h};
+    const auto                        polyphase = benchmark::ns_per_sample(
+        [&] {
+            const auto outputs = decimator.CalcBlock(in.data(), out.data(), INPUT_SAMPLES);
+            benchmark::keep(out[outputs - 1]);
+        },
+        INPUT_SAMPLES);
+
+    print("decimator", Taps, Factor, naive, polyphase);
+}
+
+/**
+ * @brief ns per output sample of the naive and the polyphase interpolator.
+ */
+template <std::size_t Taps, std::size_t Factor>
+void measure_interpolator()
+{
+    const std::size_t  samples = INPUT_SAMPLES / Factor;
+    const auto         h       = coefficients<Taps>();
+    const auto         in      = input(samples);
+    std::vector<float> out(samples * Factor);
+
+    Fir<float, Taps> fir{h};
+    const auto       naive = benchmark::ns_per_sample(
+        [&] {
+            for (std::size_t n = 0; n < samples; n++) {
+                for (std::size_t p = 0; p < Factor; p++) {
+                    out[n * Factor + p] = fir.Calc((p == 0) ? in[n] : 0.0f);
+                }
+            }
+            benchmark::keep(out.back());
+        },
+        samples * Factor);
+
+    FirInterpolator<float, Taps, Factor> interpolator{h};
+    const auto                           polyphase = benchmark::ns_per_sample(
+        [&] {
+            interpolator.CalcBlock(in.data(), out.data(), samples);
+            benchmark::keep(out.back());
+        },
+        samples * Factor);
+
+    print("interpolator", Taps, Factor, naive, polyphase);
+}
+} // namespace
+
+int main()
+{
+    std::printf("%-12s %6s %6s %12s %12s %8s\n", "filter", "taps", "factor", "naive[ns]", "poly[ns]", "speedup");
+    measure_decimator<32, 4>();
+    measure_decimator<64, 8>();
+    measure_decimator<128, 16>();
+    measure_interpolator<32, 4>();
+    measure_interpolator<64, 8>();
+    measure_interpolator<128, 16>();
+    return 0;
+}
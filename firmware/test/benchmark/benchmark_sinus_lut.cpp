@@ -0,0 +1,124 @@
+/**
+ * @file benchmark_sinus_lut.cpp
+ * @brief Spectral purity and speed of the quarter-wave SinusLUT versus the
+ *        former full-wave table with float index.
+ * @copyright (c) 2021 TOPTICA Photonics AG
+ */
+#include "benchmark.hpp"
+#include "sinusLUT.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief The former full-wave table and float index interpolation, as reference.
+ */
+class FullWaveLUT
+{
+  public:
+    FullWaveLUT()
+    {
+        for (int li = 0; li < LUT_LENGTH; li++) {
+            _LUTX[li] = li;
+            _LUTd[li] = (float)std::sin(2.0 * M_PI * li / LUT_LENGTH);
+        }
+    }
+
+    float Interp(float index) const
+    {
+        if ((index < 0)) {
+            return 0;
+        }
+
+        int  int_index   = (int)index;
+        int  next_index  = int_index + 1 < LUT_LENGTH ? int_index + 1 : int_index;
+        auto lfm         = (_LUTd[next_index] - _LUTd[int_index]) / (float)(_LUTX[next_index] - _LUTX[int_index]);
+        auto root_interp = (lfm * (index - (float)_LUTX[int_index])) + _LUTd[int_index];
+
+        if (index >= (float)LUT_LENGTH - 1) {
+            lfm         = ((_LUTd[0] - _LUTd[LUT_LENGTH - 1]));
+            root_interp = ((lfm * (index - (float)_LUTX[LUT_LENGTH - 1]))) + _LUTd[LUT_LENGTH - 1];
+        }
+
+        return (root_interp);
+    }
+
+  private:
+    int   _LUTX[LUT_LENGTH];
+    float _LUTd[LUT_LENGTH];
+};
+
+const int      N             = 1 << 16; // FFT length
+const int      CARRIER       = 1031;    // periods within the FFT
+const uint32_t PHASE_STEP    = (uint32_t)CARRIER << 16;
+const int      TIMED_SAMPLES = 1 << 22;
+
+// float index as computed by DDS::CalcFloat with a 16 bit accumulator
+float full_wave_index(uint32_t phase)
+{
+    return (float)(phase >> 16) / (float)(1 << (16 - 10));
+}
+
+} // namespace
+
+int main()
+{
+    const FullWaveLUT full_wave;
+
+    std::vector<float> signal_full(N);
+    std::vector<float> signal_quarter(N);
+    uint32_t           phase = 0;
+    for (int n = 0; n < N; n++) {
+        signal_full[n]    = full_wave.Interp(full_wave_index(phase));
+        signal_quarter[n] = sinusLUT.Interp(phase);
+        phase += PHASE_STEP;
+    }
+    const auto metrics_full    = benchmark::analyze(signal_full, CARRIER);
+    const auto metrics_quarter = benchmark::analyze(signal_quarter, CARRIER);
+
+    // random-ish phases, so the branch predictor cannot learn the quadrants
+    std::vector<uint32_t> phases(TIMED_SAMPLES);
+    uint32_t              seed = 1;
+    for (auto& p : phases) {
+        seed = seed * 1664525u + 1013904223u;
+        p    = seed & 0xffff0000u;
+    }
+
+    const auto ns_full = benchmark::ns_per_sample(
+        [&] {
+            float sum = 0;
+            for (auto p : phases) {
+                sum += full_wave.Interp(full_wave_index(p));
+            }
+            benchmark::keep(sum);
+        },
+        TIMED_SAMPLES);
+    const auto ns_quarter = benchmark::ns_per_sample(
+        [&] {
+            float sum = 0;
+            for (auto p : phases) {
+                sum += sinusLUT.Interp(p);
+            }
+            benchmark::keep(sum);
+        },
+        TIMED_SAMPLES);
+
+    std::printf("%-34s %10s %10s %10s\n", "table", "SFDR [dB]", "THD [dB]", "ns/sample");
+    std::printf(
+        "%-34s %10.1f %10.1f %10.2f\n",
+        "full-wave 1024, float index",
+        metrics_full.sfdr_db,
+        metrics_full.thd_db,
+        ns_full);
+    std::printf(
+        "%-34s %10.1f %10.1f %10.2f\n",
+        "quarter-wave 1024 + slope, phase",
+        metrics_quarter.sfdr_db,
+        metrics_quarter.thd_db,
+        ns_quarter);
+    return 0;
+}
@@ -0,0 +1,104 @@
+/**
+ * @file test_cic.cpp
+ * @brief Unit tests for the CIC component.
+ * @copyright (c) 2021 TOPTICA Photonics AG
+ */
+#include <boost/test/unit_test.hpp>
+
+#include "cic.hpp"
+
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(cic)
+
+    BOOST_AUTO_TEST_CASE(cic_max_ratio) {
+        BOOST_TEST_MESSAGE("Cic: Largest decimation ratio keeps the bit growth within 32 bit");
+
+        static_assert(Cic<3>::MaxRatio() == 1625); // 1625^3 <= 2^32 < 1626^3
+        static_assert(Cic<3, 2>::MaxRatio() == 812);
+        static_assert(Cic<1>::MaxRatio() == 0xffffffffu);
+
+        Cic<3> cic{100000, 1.0f};
+        BOOST_TEST(cic.Ratio() == 1625u);
+    }
+
+    BOOST_AUTO_TEST_CASE(cic_equals_cascaded_moving_sums) {
+        BOOST_TEST_MESSAGE("Cic: Output equals Order cascaded moving averages, decimated");
+
+        const uint32_t R = 10;
+        const int      M = 2;
+        const int      N = 3;
+        Cic<N, M>      cic{R, 4.0f};
+
+        std::vector<std::deque<double>> stages(N, std::deque<double>(R * M, 0.0));
+        std::vector<double>             sums(N, 0.0);
+
+        std::mt19937                          rng{3};
+        std::uniform_real_distribution<float> dist{-4.0f, 4.0f};
+        int                                   outputs = 0;
+        for (int n = 0; n < 100000; n++) {
+            const float x = dist(rng);
+
+            // reference in double, quantized like the CIC input
+            double value = std::round((double)x * (2147483647.0 / 4.0)) * (4.0 / 2147483647.0);
+            for (int s = 0; s < N; s++) {
+                sums[s] += value - stages[s].back();
+                stages[s].pop_back();
+                stages[s].push_front(value);
+                value = sums[s] / (R * M);
+            }
+
+            float out;
+            if (cic.Calc(x, out)) {
+                outputs++;
+                BOOST_TEST_REQUIRE(std::fabs((double)out - value) < 1e-5);
+            }
+        }
+        BOOST_TEST(outputs == 100000 / (int)R);
+    }
+
+    BOOST_AUTO_TEST_CASE(cic_dc_and_wrap) {
+        BOOST_TEST_MESSAGE("Cic: Unit DC gain, integrator wrap-around cancels, input saturates");
+
+        Cic<4> cic{64, 1.0f};
+        float  out = 0.0f;
+        for (int n = 0; n < 10000000; n++) {
+            cic.Calc(0.999f, out); // the integrators overflow many times
+        }
+        BOOST_TEST(out == 0.999f, boost::test_tools::tolerance(1e-6f));
+
+        for (int n = 0; n < 64 * 8; n++) {
+            cic.Calc(-5.0f, out);
+        }
+        BOOST_TEST(out == -1.0f, boost::test_tools::tolerance(1e-6f));
+    }
+
+    BOOST_AUTO_TEST_CASE(cic_compensation) {
+        BOOST_TEST_MESSAGE("Cic: Compensation FIR flattens the passband droop");
+
+        const uint32_t R      = 16;
+        const float    cutoff = 0.25f;
+        const auto     h      = Cic<3, 1, 15>::Compensation(R, cutoff);
+
+        double max_droop = 0.0, max_compensated = 0.0;
+        for (double f = 0.01; f <= 0.8 * (double)cutoff; f += 0.01) {
+            const double cic = std::pow(std::sin(M_PI * f) / (R * std::sin(M_PI * f / R)), 3.0);
+
+            std::complex<double> fir = 0.0;
+            for (std::size_t k = 0; k < h.size(); k++) {
+                fir += (double)h[k] * std::polar(1.0, -2.0 * M_PI * f * (double)k);
+            }
+            max_droop       = std::max(max_droop, std::fabs(20.0 * std::log10(cic)));
+            max_compensated = std::max(max_compensated, std::fabs(20.0 * std::log10(cic * std::abs(fir))));
+        }
+        BOOST_TEST_MESSAGE("passband droop " << max_droop << " dB, compensated " << max_compensated << " dB");
+        BOOST_TEST(max_compensated < 0.1);
+        BOOST_TEST(max_compensated < max_droop / 10.0);
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
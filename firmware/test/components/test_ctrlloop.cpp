@@ -0,0 +1,339 @@
+/**
+ * @file test_ctrlloop.cpp
+ * @brief Unit tests for the CtrlLoop component.
+ * @copyright (c) 2021 TOPTICA Photonics AG
+ */
+#include <boost/test/unit_test.hpp>
+
+#include "channelEngine.hpp"
+#include "cic.hpp"
+#include "ctrlLoop.hpp"
+#include "dds.hpp"
+#include "fir.hpp"
+#include "lockIn.hpp"
+#include "sinusLUT.hpp"
+#include <tsp/pid.hpp>
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <random>
+#include <type_traits>
+
+namespace {
+/**
+ * @brief One channel of the ChannelEngine from the single-channel
+ * components, as reference: DDS, Boxcar, Cic and `tsp::pid::pid`.
+ */
+class ChannelLoop
+{
+  public:
+    ChannelLoop(const PIDParam& pid_param, DDSParam& dds_param, float FIRfreq)
+      : _dds(dds_param),
+        _fir((std::size_t)std::lround(CtrlFreq / FIRfreq)),
+        _cic((uint32_t)CountLim, CIC_FULL_SCALE),
+        _pidf(TS, pid_param.kpf, pid_param.kif, pid_param.kdf),
+        _pids(CountLim * TS, pid_param.kps, pid_param.kis, pid_param.kds)
+    {
+        _pidf.enable();
+        _pids.enable();
+    }
+
+    void step(float error, float& sctrl_out, float& fctrl_out)
+    {
+        float reference, referenceShift;
+        _dds.Calc(reference, referenceShift);
+        const float demodulated = error * referenceShift;
+        fctrl_out               = _pidf.run(_fir.Calc(demodulated));
+
+        float slowSig;
+        if (_cic.Calc(demodulated, slowSig)) {
+            _sctrl = _pids.run(slowSig);
+        }
+        sctrl_out = _sctrl;
+    }
+
+  private:
+    DDS                           _dds;
+    Boxcar<float, FIR_MAX_LENGTH> _fir;
+    Cic<CIC_ORDER>                _cic;
+    toptica::tsp::pid::pid<float> _pidf;
+    toptica::tsp::pid::pid<float> _pids;
+    float                         _sctrl = 0.0f;
+};
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(ctrlloop)
+
+    BOOST_AUTO_TEST_CASE(boxcar_bank_equals_boxcars) {
+        BOOST_TEST_MESSAGE("BoxcarBank: Every channel is bit-identical to a Boxcar");
+
+        BoxcarBank<float, 3, 64>         bank{50};
+        std::array<Boxcar<float, 64>, 3> boxcars{Boxcar<float, 64>{50}, Boxcar<float, 64>{50}, Boxcar<float, 64>{50}};
+        BOOST_TEST(bank.Length() == 50u);
+
+        std::mt19937                          rng{11};
+        std::uniform_real_distribution<float> dist{-1.0f, 1.0f};
+        for (int n = 0; n < 100000; n++) {
+            // a new length restarts the averages, the bank without clearing its delay line
+            if (n == 50000 || n == 50010) {
+                const std::size_t length = (n == 50000) ? 64 : 30;
+                bank.SetLength(length);
+                for (auto& boxcar : boxcars) {
+                    boxcar.SetLength(length);
+                }
+            }
+            const std::array<float, 3> in{dist(rng), 100.0f + dist(rng), -1e-3f * dist(rng)};
+            std::array<float, 3>       out;
+            bank.Calc(in, out);
+            for (std::size_t k = 0; k < 3; k++) {
+                const float expected = boxcars[k].Calc(in[k]);
+                BOOST_TEST_REQUIRE(std::memcmp(&out[k], &expected, sizeof(float)) == 0);
+            }
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(channel_engine_equals_single_channels) {
+        BOOST_TEST_MESSAGE("ChannelEngine: Every channel is bit-identical to the single-channel components");
+
+        const float FIRfreq = 2000.0f;
+        PIDParam    pid[3]{
+            {1.0f, 100.0f, 1e-5f, 0.5f, 10.0f, 0.0f},
+            {2.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1e-4f},
+            {0.5f, 1000.0f, 0.0f, 2.0f, 50.0f, 0.0f},
+        };
+        DDSParam dds[3]{
+            {true, 1.0f, 1.0f, 20000.0f, 0.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT},
+            {true, 0.5f, 0.0f, 12345.0f, 30.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT},
+            {false, 1.0f, 0.0f, 1000.0f, 0.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT},
+        };
+
+        ChannelEngine<3>             engine{pid[0], dds[0], FIRfreq};
+        std::unique_ptr<ChannelLoop> loops[3];
+        for (std::size_t k = 0; k < 3; k++) {
+            engine.SetChannel(k, pid[k], dds[k]);
+            loops[k] = std::make_unique<ChannelLoop>(pid[k], dds[k], FIRfreq);
+        }
+
+        std::mt19937                          rng{13};
+        std::uniform_real_distribution<float> dist{-1.0f, 1.0f};
+        std::array<float, 3>                  expectedSlow{};
+        for (int n = 0; n < 20000; n++) {
+            std::array<float, 3> error;
+            for (auto& e : error) {
+                e = dist(rng);
+            }
+            std::array<float, 3> sctrl, fctrl;
+            engine.step(error, sctrl, fctrl);
+            for (std::size_t k = 0; k < 3; k++) {
+                float fast;
+                loops[k]->step(error[k], expectedSlow[k], fast);
+                BOOST_TEST_REQUIRE(std::memcmp(&fctrl[k], &fast, sizeof(float)) == 0);
+                BOOST_TEST_REQUIRE(std::memcmp(&sctrl[k], &expectedSlow[k], sizeof(float)) == 0);
+            }
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(channel_engine_split_step) {
+        BOOST_TEST_MESSAGE("ChannelEngine: stepFast every tick and stepSlow every CountLim ticks equal step");
+
+        PIDParam pid{1.0f, 100.0f, 1e-5f, 0.5f, 10.0f, 0.0f};
+        DDSParam dds{true, 1.0f, 1.0f, 20000.0f, 0.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT};
+
+        ChannelEngine<3> engine{pid, dds, 2000.0f};
+        ChannelEngine<3> split{pid, dds, 2000.0f};
+
+        std::mt19937                          rng{17};
+        std::uniform_real_distribution<float> dist{-1.0f, 1.0f};
+        std::array<float, 3>                  splitSlow{};
+        for (int n = 0; n < 20000; n++) {
+            std::array<float, 3> error;
+            for (auto& e : error) {
+                e = dist(rng);
+            }
+            std::array<float, 3> sctrl, fctrl, splitFast;
+            engine.step(error, sctrl, fctrl);
+            split.stepFast(error, splitFast);
+            // the slow rate group of the application: phase CountLim - 1
+            if (n % CountLim == CountLim - 1) {
+                split.stepSlow(splitSlow);
+            }
+            BOOST_TEST_REQUIRE(std::memcmp(&fctrl, &splitFast, sizeof(fctrl)) == 0);
+            if (n % CountLim == CountLim - 1) {
+                BOOST_TEST_REQUIRE(std::memcmp(&sctrl, &splitSlow, sizeof(sctrl)) == 0);
+            }
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(channel_engine_apply_param) {
+        BOOST_TEST_MESSAGE("ChannelEngine: An applied parameter set equals constructing with it");
+
+        PIDParam pid0{0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+        PIDParam pid1{1.0f, 100.0f, 1e-5f, 0.5f, 10.0f, 0.0f};
+        DDSParam dds0{false, 0.0f, 0.0f, 1000.0f, 0.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT};
+        DDSParam dds1{true, 1.0f, 1.0f, 20000.0f, 30.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT};
+
+        ChannelEngine<3> expected{pid1, dds1, 2000.0f};
+        ChannelEngine<3> engine{pid0, dds0, 5000.0f};
+        const auto       param = ChannelEngine<3>::Param(pid1, dds1, 2000.0f);
+        engine.ApplyFast(param);
+        engine.ApplySlow(param);
+
+        std::mt19937                          rng{23};
+        std::uniform_real_distribution<float> dist{-1.0f, 1.0f};
+        for (int n = 0; n < 5000; n++) {
+            std::array<float, 3> error;
+            for (auto& e : error) {
+                e = dist(rng);
+            }
+            std::array<float, 3> sctrl, fctrl, expectedSlow, expectedFast;
+            expected.step(error, expectedSlow, expectedFast);
+            engine.step(error, sctrl, fctrl);
+            BOOST_TEST_REQUIRE(std::memcmp(&fctrl, &expectedFast, sizeof(fctrl)) == 0);
+            BOOST_TEST_REQUIRE(std::memcmp(&sctrl, &expectedSlow, sizeof(sctrl)) == 0);
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(iir_filter_stage) {
+        BOOST_TEST_MESSAGE("IirFilter: Unit DC gain, -3 dB at the corner, every channel a tsp static_iir");
+
+        constexpr float corner = 1000.0f;
+        {
+            IirFilter<2>         filter{corner};
+            std::array<float, 2> y{};
+            for (int n = 0; n < 5000; n++) {
+                filter.Calc({1.0f, -0.5f}, y);
+            }
+            BOOST_TEST(std::fabs(y[0] - 1.0f) < 1e-4f);
+            BOOST_TEST(std::fabs(y[1] + 0.5f) < 1e-4f);
+        }
+        {
+            IirFilter<1> filter{corner};
+            float        peak = 0.0f;
+            for (int n = 0; n < 10000; n++) {
+                std::array<float, 1> y;
+                filter.Calc({std::sin(2.0f * (float)M_PI * corner / CtrlFreq * (float)n)}, y);
+                if (n >= 5000) {
+                    peak = std::fmax(peak, std::fabs(y[0]));
+                }
+            }
+            BOOST_TEST(std::fabs(peak - (float)M_SQRT1_2) < 5e-3f);
+        }
+
+        // the compile-time design equals the run-time one
+        constexpr auto coefficients = IirFilter<1>::Setting(corner);
+        IirFilter<1>   fromCorner{corner};
+        BOOST_TEST(IirFilter<1>{coefficients}.Coefficients().a == fromCorner.Coefficients().a);
+        BOOST_TEST(IirFilter<1>{coefficients}.Coefficients().b == fromCorner.Coefficients().b);
+
+        IirFilter<3>                                           bank{corner};
+        std::array<toptica::tsp::iir::static_iir<float, 2>, 3> single;
+        std::mt19937                                           rng{29};
+        std::uniform_real_distribution<float>                  dist{-1.0f, 1.0f};
+        single.fill(toptica::tsp::iir::static_iir<float, 2>{coefficients});
+        for (int n = 0; n < 10000; n++) {
+            const std::array<float, 3> in{dist(rng), 1.0f + dist(rng), 1e-3f * dist(rng)};
+            std::array<float, 3>       out;
+            bank.Calc(in, out);
+            for (std::size_t k = 0; k < 3; k++) {
+                const float expected = single[k].filter(in[k]);
+                BOOST_TEST_REQUIRE(std::memcmp(&out[k], &expected, sizeof(float)) == 0);
+            }
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(channel_engine_iir_filter) {
+        BOOST_TEST_MESSAGE("ChannelEngine: The filter stage only feeds the fast path");
+
+        PIDParam pid{1.0f, 100.0f, 0.0f, 0.5f, 10.0f, 0.0f};
+        DDSParam dds{true, 1.0f, 0.0f, 20000.0f, 0.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT};
+
+        ChannelEngine<2>                  boxcarEngine{pid, dds, 2000.0f};
+        ChannelEngine<2, IirFilter<2>>    iirEngine{pid, dds, 1000.0f};
+        ChannelEngine<2, IirFilter<2, 1>> firstOrderEngine{pid, dds, 1000.0f};
+        int                               orderDiffers = 0;
+        for (int n = 0; n < 2000; n++) {
+            if (n == 1000) {
+                iirEngine.ApplyFast(ChannelEngine<2, IirFilter<2>>::Param(pid, dds, 500.0f));
+            }
+            const std::array<float, 2> error{std::sin(0.3f * (float)n), std::cos(0.2f * (float)n)};
+            std::array<float, 2>       boxcarSlow, boxcarFast, iirSlow, iirFast, firstOrderSlow, firstOrderFast;
+            boxcarEngine.step(error, boxcarSlow, boxcarFast);
+            iirEngine.step(error, iirSlow, iirFast);
+            firstOrderEngine.step(error, firstOrderSlow, firstOrderFast);
+            BOOST_TEST_REQUIRE(std::memcmp(&boxcarSlow, &iirSlow, sizeof(iirSlow)) == 0);
+            BOOST_TEST_REQUIRE(std::memcmp(&boxcarSlow, &firstOrderSlow, sizeof(iirSlow)) == 0);
+            BOOST_TEST_REQUIRE((std::isfinite(iirFast[0]) && std::isfinite(iirFast[1])));
+            orderDiffers += (iirFast[0] != firstOrderFast[0]) ? 1 : 0;
+        }
+        BOOST_TEST(orderDiffers > 1900);
+    }
+
+    BOOST_AUTO_TEST_CASE(channel_engine_pid_limits_and_hold) {
+        BOOST_TEST_MESSAGE("ChannelEngine: Fast PIDs are limited per loop and held loops keep their output");
+
+        PIDParam pid{1.0f, 100.0f, 0.0f, 0.5f, 10.0f, 0.0f};
+        DDSParam dds{true, 1.0f, 0.0f, 20000.0f, 0.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT};
+
+        ChannelEngine<2> engine{pid, dds, 2000.0f};
+        engine.FastPids().set_control_variable_limits(0, -0.1f, 0.1f);
+        std::array<float, 2> slow{}, fast{}, held{};
+        for (int n = 0; n < 2000; n++) {
+            if (n == 1000) {
+                engine.FastPids().hold(1);
+                held = fast;
+            }
+            const float error = std::sin(2.0f * (float)M_PI * 20000.0f / CtrlFreq * (float)n);
+            engine.step({error, error}, slow, fast);
+            BOOST_TEST_REQUIRE((fast[0] >= -0.1f && fast[0] <= 0.1f));
+            if (n >= 1000) {
+                BOOST_TEST_REQUIRE(fast[1] == held[1]);
+            }
+        }
+        BOOST_TEST(engine.FastPids().is_limited(0));
+        BOOST_TEST(fast[1] > 0.1f);
+    }
+
+    BOOST_AUTO_TEST_CASE(channel_engine_stages) {
+        BOOST_TEST_MESSAGE("ChannelEngine: Stages are template parameters, e.g. fast PIDs with anti-windup");
+
+        using AntiWindupPids =
+            toptica::tsp::pid::pid_bank<float, 2, toptica::tsp::pid::anti_windup::conditional_integration>;
+        using DefaultStages =
+            ChannelEngine<2, BoxcarFilter<2>, DDSBank<2>, CicDemodulator<2>, toptica::tsp::pid::pid_bank<float, 2>>;
+        static_assert(std::is_same<ChannelEngine<2>, DefaultStages>::value, "Default stages changed");
+
+        PIDParam pid{1.0f, 100.0f, 0.0f, 0.5f, 10.0f, 0.0f};
+        DDSParam dds{true, 1.0f, 0.0f, 20000.0f, 0.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT};
+
+        ChannelEngine<2>                                                                engine{pid, dds, 2000.0f};
+        ChannelEngine<2, BoxcarFilter<2>, DDSBank<2>, CicDemodulator<2>, AntiWindupPids> antiWindup{pid, dds, 2000.0f};
+        engine.FastPids().set_control_variable_limits(0, -0.1f, 0.1f);
+        antiWindup.FastPids().set_control_variable_limits(0, -0.1f, 0.1f);
+        int limitedSamples           = 0;
+        int antiWindupLimitedSamples = 0;
+        for (int n = 0; n < 4000; n++) {
+            // in phase with the reference for 2000 samples, then in antiphase
+            const float sign  = (n < 2000) ? 1.0f : -1.0f;
+            const float error = sign * std::sin(2.0f * (float)M_PI * 20000.0f / CtrlFreq * (float)n);
+            std::array<float, 2> slow{}, fast{}, antiWindupSlow{}, antiWindupFast{};
+            engine.step({error, error}, slow, fast);
+            antiWindup.step({error, error}, antiWindupSlow, antiWindupFast);
+            // the unlimited channel and the slow path are not affected
+            BOOST_TEST_REQUIRE(fast[1] == antiWindupFast[1]);
+            BOOST_TEST_REQUIRE(std::memcmp(&slow, &antiWindupSlow, sizeof(slow)) == 0);
+            if (n >= 2000) {
+                limitedSamples += (fast[0] == 0.1f) ? 1 : 0;
+                antiWindupLimitedSamples += (antiWindupFast[0] == 0.1f) ? 1 : 0;
+            }
+        }
+        // the wound up integrator holds the output at the limit after the
+        // error reversed
+        BOOST_TEST_MESSAGE("samples at the limit after the reversal " << limitedSamples << ", with anti-windup "
+                                                                     << antiWindupLimitedSamples);
+        BOOST_TEST(antiWindupLimitedSamples < limitedSamples);
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,603 @@
+/**
+ * @file test_dds.cpp
+ * @brief Unit tests for the DDS component.
+ * @copyright (c) 2021 TOPTICA Photonics AG
+ */
+#include <boost/test/unit_test.hpp>
+
+#include "dds.hpp"
+#include "ddsBank.hpp"
+#include "sinePolicy.hpp"
+#include "sinusLUT.hpp"
+#include "waveTable.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+const uint32_t CtrlFreq = 100e3;
+
+bool bit_identical(float a, float b)
+{
+    return std::memcmp(&a, &b, sizeof(float)) == 0;
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(dds)
+
+    BOOST_AUTO_TEST_CASE(sinus_lut_compile_time) {
+        BOOST_TEST_MESSAGE("SinusLUT: Table is generated at compile time and matches std::sin");
+
+        constexpr SinusLUT<64> lut64{};
+        static_assert(lut64.bits == 8);
+        static_assert(SinusLUT<>::length == LUT_LENGTH);
+
+        // all full-wave grid points (the mirrored quadrants are off by one phase LSB)
+        for (uint32_t i = 0; i < (1u << SinusLUT<>::bits); i++) {
+            const auto phase = i << (32 - SinusLUT<>::bits);
+            BOOST_TEST_REQUIRE(
+                std::fabs((double)sinusLUT.Interp(phase) - std::sin(2.0 * M_PI * i / (1u << SinusLUT<>::bits))) < 1e-7);
+        }
+        for (uint32_t i = 0; i < (1u << lut64.bits); i++) {
+            BOOST_TEST_REQUIRE(std::fabs(lut64.Interp(i << 24) - sinusLUT.Interp(i << 24)) < 1e-6);
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(sinus_lut_interpolation_error) {
+        BOOST_TEST_MESSAGE("SinusLUT: Interpolation error between the grid points");
+
+        double   max_error = 0;
+        uint32_t phase     = 0;
+        for (int n = 0; n < 1000000; n++) {
+            phase += 2654435761u; // golden ratio phase step, covers the full circle
+            const auto error = std::fabs((double)sinusLUT.Interp(phase) - std::sin(2.0 * M_PI * phase / 0x1p32));
+            max_error        = std::max(max_error, error);
+        }
+        // linear interpolation error (π/2/1024)^2/8 plus float rounding
+        BOOST_TEST(max_error < 5e-7);
+    }
+
+    BOOST_AUTO_TEST_CASE(sinus_lut_iq) {
+        BOOST_TEST_MESSAGE("SinusLUT: Sine and cosine from one phase-to-index step");
+
+        uint32_t phase = 0;
+        for (int n = 0; n < 1000000; n++) {
+            phase += 2654435761u;
+            float sin, cos;
+            sinusLUT.InterpIQ(phase, sin, cos);
+            BOOST_TEST_REQUIRE(bit_identical(sin, sinusLUT.Interp(phase)));
+            BOOST_TEST_REQUIRE(bit_identical(cos, sinusLUT.Interp(phase + 0x40000000u)));
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(sinus_lut_lookup) {
+        BOOST_TEST_MESSAGE("SinusLUT: Lookup without interpolation is off by at most one grid step");
+
+        const double grid  = 2.0 * M_PI / (1u << SinusLUT<>::bits);
+        uint32_t     phase = 0;
+        for (int n = 0; n < 1000000; n++) {
+            phase += 2654435761u;
+            const double x = 2.0 * M_PI * phase / 4294967296.0;
+            BOOST_TEST_REQUIRE(std::fabs((double)sinusLUT.Lookup(phase) - std::sin(x)) < grid);
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(sine_policy_cordic) {
+        BOOST_TEST_MESSAGE("CordicSine: Sine and cosine over the full circle");
+
+        double   max_error = 0.0;
+        uint32_t phase     = 0;
+        for (int n = 0; n < 1000000; n++) {
+            phase += 2654435761u;
+            float sin, cos;
+            CordicSine::Rotate(phase, sin, cos);
+            const double x = 2.0 * M_PI * phase / 4294967296.0;
+            max_error      = std::max(max_error, std::fabs((double)sin - std::sin(x)));
+            max_error      = std::max(max_error, std::fabs((double)cos - std::cos(x)));
+        }
+        BOOST_TEST_MESSAGE("max. error " << max_error);
+        BOOST_TEST(max_error < 5e-7);
+    }
+
+    BOOST_AUTO_TEST_CASE(dds_sine_policies) {
+        BOOST_TEST_MESSAGE("DDS: CORDIC and resonator policies follow the LUT DDS, also when retuned");
+
+        DDSParam     param{true, 0.5f, 0.25f, 1234.0f, 30.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT};
+        DDS          lut{param};
+        CordicDDS    cordic{param};
+        ResonatorDDS resonator{param};
+
+        double max_cordic    = 0.0;
+        double max_resonator = 0.0;
+        for (int n = 0; n < 100000; n++) {
+            if (n == 50000) {
+                lut.SetFrequency(4321.0f);
+                cordic.SetFrequency(4321.0f);
+                resonator.SetFrequency(4321.0f);
+            }
+            float out[3], shift_out[3];
+            lut.Calc(out[0], shift_out[0]);
+            cordic.Calc(out[1], shift_out[1]);
+            resonator.Calc(out[2], shift_out[2]);
+            auto deviation = [&](int k) {
+                return (double)std::max(std::fabs(out[k] - out[0]), std::fabs(shift_out[k] - shift_out[0]));
+            };
+            max_cordic    = std::max(max_cordic, deviation(1));
+            max_resonator = std::max(max_resonator, deviation(2));
+        }
+        BOOST_TEST_MESSAGE("max. deviation CORDIC " << max_cordic << ", resonator " << max_resonator);
+        BOOST_TEST(max_cordic < 1e-6);
+        BOOST_TEST(max_resonator < 3e-5);
+
+        float i[2], q[2];
+        for (int n = 0; n < 1000; n++) {
+            lut.CalcIQ(i[0], q[0]);
+            resonator.CalcIQ(i[1], q[1]);
+            BOOST_TEST_REQUIRE(std::fabs(i[1] - i[0]) < 3e-5);
+            BOOST_TEST_REQUIRE(std::fabs(q[1] - q[0]) < 3e-5);
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(dds_iq) {
+        BOOST_TEST_MESSAGE("DDS: In-phase output of CalcIQ equals the shifted output of Calc");
+
+        DDSParam param{true, 1.5f, 0.25f, 1234.5f, 30.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT};
+        DDS      dds_calc{param};
+        DDS      dds_quadrature{param};
+
+        for (int n = 0; n < 100000; n++) {
+            float out, shift_out, i_out, q_out;
+            dds_calc.Calc(out, shift_out);
+            dds_quadrature.CalcIQ(i_out, q_out);
+            BOOST_TEST_REQUIRE(bit_identical(i_out, shift_out));
+            const float sin = (i_out - 0.25f) / 1.5f;
+            const float cos = (q_out - 0.25f) / 1.5f;
+            BOOST_TEST_REQUIRE(std::fabs(sin * sin + cos * cos - 1.0f) < 1e-5f);
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(dds_block) {
+        BOOST_TEST_MESSAGE("DDS: Block generation equals consecutive single samples");
+
+        for (bool enable : {true, false}) {
+            DDSParam param{enable, 1.5f, 0.25f, 1234.5f, 30.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT};
+            DDS      dds_single{param};
+            DDS      dds_blocks{param};
+            DDS      dds_iq_block{param};
+
+            float block[100], i_block[100], q_block[100];
+            for (int b = 0; b < 50; b++) {
+                const std::size_t n = (std::size_t)(b % 7) * 13 + 1;
+                dds_blocks.CalcBlock(block, n);
+                dds_iq_block.CalcIQBlock(i_block, q_block, n);
+                for (std::size_t k = 0; k < n; k++) {
+                    float out, shift_out;
+                    dds_single.Calc(out, shift_out);
+                    BOOST_TEST_REQUIRE(bit_identical(block[k], shift_out));
+                    BOOST_TEST_REQUIRE(bit_identical(i_block[k], shift_out));
+                }
+            }
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(dds_bank) {
+        BOOST_TEST_MESSAGE("DDSBank: Every tone equals a separate DDS");
+
+        const DDSParam params[] = {
+            {true, 1.0f, 0.0f, 20000.0f, 0.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT},
+            {true, 0.5f, 0.1f, 40000.0f, 20.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT},
+            {false, 1.0f, 1.0f, 60000.0f, 0.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT},
+            {true, 2.0f, -1.0f, 1234.5f, 10.0f, CtrlFreq, 20, SinusLUT<>::bits, sinusLUT},
+        };
+
+        DDSBank<4> bank;
+        DDSBank<4> bank_iq;
+        DDS        single[] = {DDS{params[0]}, DDS{params[1]}, DDS{params[2]}, DDS{params[3]}};
+        for (std::size_t k = 0; k < 4; k++) {
+            bank.SetTone(k, params[k]);
+            bank_iq.SetTone(k, params[k]);
+        }
+
+        for (int n = 0; n < 100000; n++) {
+            std::array<float, 4> out, i_out, q_out;
+            bank.Calc(out);
+            bank_iq.CalcIQ(i_out, q_out);
+            for (std::size_t k = 0; k < 4; k++) {
+                float i_single, q_single;
+                single[k].CalcIQ(i_single, q_single);
+                BOOST_TEST_REQUIRE(bit_identical(out[k], i_single));
+                BOOST_TEST_REQUIRE(bit_identical(i_out[k], i_single));
+                BOOST_TEST_REQUIRE(bit_identical(q_out[k], q_single));
+            }
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(dds_lut_length) {
+        BOOST_TEST_MESSAGE("DDS: A DDS and a DDSBank with a shorter sine table use the shared table of its length");
+
+        constexpr std::size_t length = 256;
+        BOOST_TEST(&sharedSinusLUT<> == &sinusLUT);
+        BOOST_TEST(SinusLUT<length>::bits == 10);
+
+        DDSParam           param{true, 1.5f, 0.25f, 1234.5f, 30.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT};
+        CompactDDS         compact{param};
+        DDSBank<1, length> bank;
+        bank.SetTone(0, param);
+
+        uint32_t       phase = 0;
+        const uint32_t step  = (uint32_t)DDS::TuningWord(1234.5f, CtrlFreq, 16) << 16;
+        const uint32_t shift = (uint32_t)DDS::PhaseOffsetWord(30.0f, 16) << 16;
+        float          max_deviation = 0.0f;
+        for (int n = 0; n < 100000; n++) {
+            float                out, shift_out;
+            std::array<float, 1> bank_out;
+            compact.Calc(out, shift_out);
+            bank.Calc(bank_out);
+            phase += step;
+            BOOST_TEST_REQUIRE(bit_identical(out, sharedSinusLUT<length>.Interp(phase)));
+            BOOST_TEST_REQUIRE(bit_identical(shift_out, sharedSinusLUT<length>.Interp(phase + shift) * 1.5f + 0.25f));
+            BOOST_TEST_REQUIRE(bit_identical(bank_out[0], shift_out));
+            max_deviation = std::max(max_deviation, std::fabs(out - sinusLUT.Interp(phase)));
+        }
+        // interpolation error (π/2/256)^2/8
+        BOOST_TEST(max_deviation < 1e-5f);
+    }
+
+    BOOST_AUTO_TEST_CASE(dds_bank_retune) {
+        BOOST_TEST_MESSAGE("DDSBank: Retune keeps the phase, SetTone restarts it");
+
+        DDSParam   param{true, 1.0f, 0.0f, 1000.0f, 0.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT};
+        DDSParam   retuned{true, 0.5f, 0.25f, 3000.0f, 0.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT};
+        DDSBank<1> bank;
+        bank.SetTone(0, param);
+
+        uint32_t phase = 0;
+        uint32_t step  = (uint32_t)DDS::TuningWord(1000.0f, CtrlFreq, 16) << 16;
+        float    amp   = 1.0f;
+        float    offs  = 0.0f;
+        for (int n = 0; n < 3000; n++) {
+            if (n == 1000) {
+                bank.Retune(0, retuned);
+                step = (uint32_t)DDS::TuningWord(3000.0f, CtrlFreq, 16) << 16;
+                amp  = 0.5f;
+                offs = 0.25f;
+            }
+            if (n == 2000) {
+                bank.SetTone(0, retuned);
+                phase = 0;
+            }
+            std::array<float, 1> out;
+            bank.Calc(out);
+            phase += step;
+            BOOST_TEST_REQUIRE(bit_identical(out[0], sinusLUT.Interp(phase) * amp + offs));
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(dds_phase_offset) {
+        BOOST_TEST_MESSAGE("DDS: A phase offset of 90° turns the sine into a cosine");
+
+        DDS dds_ref{DDSParam{true, 1.0f, 0.0f, 1234.5f, 0.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT}};
+        DDS dds_shifted{DDSParam{true, 1.0f, 0.0f, 1234.5f, 90.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT}};
+
+        for (int n = 0; n < 10000; n++) {
+            float i_ref, q_ref, out, shift_out;
+            dds_ref.CalcIQ(i_ref, q_ref);
+            dds_shifted.Calc(out, shift_out);
+            BOOST_TEST_REQUIRE(bit_identical(shift_out, q_ref));
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(dds_retuning) {
+        BOOST_TEST_MESSAGE("DDS: Retuning takes effect with the next sample without phase discontinuity");
+
+        DDSParam param{true, 1.0f, 0.0f, 1000.0f, 0.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT};
+        DDS      dds{param};
+
+        // model of the expected phase in accumulator units
+        uint32_t phase = 0;
+        uint32_t step  = (uint32_t)DDS::TuningWord(1000.0f, CtrlFreq, 16) << 16;
+        uint32_t shift = 0;
+        float    amp   = 1.0f;
+        float    offs  = 0.0f;
+
+        for (int n = 0; n < 3000; n++) {
+            if (n == 1000) {
+                dds.SetFrequency(3000.0f);
+                step = (uint32_t)DDS::TuningWord(3000.0f, CtrlFreq, 16) << 16;
+            }
+            if (n == 2000) {
+                dds.SetPhaseOffset(45.0f);
+                dds.SetAmplitude(0.5f, 0.25f);
+                shift = 1u << 29;
+                amp   = 0.5f;
+                offs  = 0.25f;
+            }
+            float out, shift_out;
+            dds.Calc(out, shift_out);
+            phase += step;
+            BOOST_TEST_REQUIRE(bit_identical(out, sinusLUT.Interp(phase)));
+            BOOST_TEST_REQUIRE(bit_identical(shift_out, sinusLUT.Interp(phase + shift) * amp + offs));
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(wave_table) {
+        BOOST_TEST_MESSAGE("WaveTable: Triangle and sawtooth interpolate exactly, user tables wrap around");
+
+        static_assert(WaveTable<>::bits == 8);
+
+        for (uint32_t i = 0; i < 4096; i++) {
+            const auto   phase = i * 1048573u; // odd step: hits all fractions
+            const double x     = phase / 4294967296.0;
+            const double tri   = (x < 0.25) ? 4.0 * x : (x < 0.75) ? 2.0 - 4.0 * x : 4.0 * x - 4.0;
+            const double saw   = (x < 0.5) ? 2.0 * x : 2.0 * x - 2.0;
+            BOOST_TEST_REQUIRE(std::fabs((double)triangleTable.Interp(phase) - tri) < 1e-6);
+            BOOST_TEST_REQUIRE(std::fabs((double)sawtoothTable.Interp(phase) - saw) < 1e-6);
+        }
+
+        float samples[WaveTable<>::length];
+        for (std::size_t i = 0; i < WaveTable<>::length; i++) {
+            samples[i] = (float)i;
+        }
+        WaveTable<> table;
+        table.Load(samples);
+        BOOST_TEST(table.Interp(5u << 24) == 5.0f);
+        BOOST_TEST(table.Interp((5u << 24) + (1u << 23)) == 5.5f);
+        BOOST_TEST(table.Interp(0xff800000u) == 127.5f); // halfway from the last sample back to the first
+
+        WaveTableBuffer buffer;
+        const auto&     first  = buffer.Load(samples);
+        const auto&     second = buffer.Load(samples);
+        BOOST_TEST(&first != &second);
+        BOOST_TEST(&buffer.Load(samples) == &first);
+    }
+
+    BOOST_AUTO_TEST_CASE(dds_waveform) {
+        BOOST_TEST_MESSAGE("DDS: Waveform switches with the next sample and all outputs use it");
+
+        DDSParam param{true, 0.5f, 0.25f, 1000.0f, 30.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT};
+        DDS      dds{param};
+        DDS      dds_block{param};
+
+        const uint32_t step  = (uint32_t)DDS::TuningWord(1000.0f, CtrlFreq, 16) << 16;
+        const uint32_t shift = (uint32_t)DDS::PhaseOffsetWord(30.0f, 16) << 16;
+
+        float samples[WaveTable<>::length];
+        for (std::size_t i = 0; i < WaveTable<>::length; i++) {
+            samples[i] = (float)std::sin(4.0 * M_PI * (double)i / WaveTable<>::length);
+        }
+        WaveTableBuffer buffer;
+
+        uint32_t phase = 0;
+        for (int selected = 0; selected < 4; selected++) {
+            const WaveTable<>* table = nullptr;
+            switch (selected) {
+                case 0:
+                    table = &triangleTable;
+                    dds.SetWaveform(Waveform::triangle);
+                    dds_block.SetWaveform(Waveform::triangle);
+                    break;
+                case 1:
+                    table = &sawtoothTable;
+                    dds.SetWaveform(Waveform::sawtooth);
+                    dds_block.SetWaveform(Waveform::sawtooth);
+                    break;
+                case 2:
+                    table = &buffer.Load(samples);
+                    dds.SetWaveform(*table);
+                    dds_block.SetWaveform(*table);
+                    break;
+                default:
+                    dds.SetWaveform(Waveform::sine);
+                    dds_block.SetWaveform(Waveform::sine);
+                    break;
+            }
+            auto interp = [&](uint32_t p) { return (table != nullptr) ? table->Interp(p) : sinusLUT.Interp(p); };
+
+            float block[100];
+            dds_block.CalcBlock(block, 100);
+            for (float sample : block) {
+                float out, shift_out;
+                dds.Calc(out, shift_out);
+                phase += step;
+                BOOST_TEST_REQUIRE(bit_identical(out, interp(phase)));
+                BOOST_TEST_REQUIRE(bit_identical(shift_out, interp(phase + shift) * 0.5f + 0.25f));
+                BOOST_TEST_REQUIRE(bit_identical(sample, shift_out));
+            }
+
+            float i_out, q_out;
+            dds.CalcIQ(i_out, q_out);
+            dds_block.CalcBlock(block, 1);
+            phase += step;
+            BOOST_TEST_REQUIRE(bit_identical(i_out, interp(phase + shift) * 0.5f + 0.25f));
+            BOOST_TEST_REQUIRE(bit_identical(q_out, interp(phase + shift + (1u << 30)) * 0.5f + 0.25f));
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(dds_sweep_linear) {
+        BOOST_TEST_MESSAGE("DDS: Linear single sweep runs from start to stop frequency and holds it");
+
+        DDSParam param{true, 1.0f, 0.0f, 1000.0f, 0.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT};
+        DDS      dds{param};
+        DDSSweep sweep{{1000.0f, 5000.0f, 4000, SweepShape::linear, SweepMode::single, CtrlFreq}};
+
+        dds.StartSweep(sweep);
+        float last = 0.0f;
+        for (int n = 0; n < 6000; n++) {
+            float out, shift_out;
+            dds.Calc(out, shift_out);
+            const float expected = (n + 1 < 4000) ? 1000.0f + 4000.0f * (float)(n + 1) / 4000.0f : 5000.0f;
+            BOOST_TEST_REQUIRE(std::fabs(dds.GetFrequency() - expected) < 1e-3f);
+
+            // no phase discontinuity: the output changes at most by the phase step
+            BOOST_TEST_REQUIRE(std::fabs(out - last) <= 2.0f * (float)M_PI * 5000.0f / CtrlFreq);
+            last = out;
+        }
+
+        dds.StopSweep();
+        float out, shift_out;
+        dds.Calc(out, shift_out);
+        BOOST_TEST(std::fabs(dds.GetFrequency() - 1000.0f) < 1.0f);
+    }
+
+    BOOST_AUTO_TEST_CASE(dds_sweep_modes) {
+        BOOST_TEST_MESSAGE("DDS: Repeat sweep restarts, triangle sweep turns at the stop frequency");
+
+        DDSParam param{true, 1.0f, 0.0f, 1000.0f, 0.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT};
+        DDS      repeat_dds{param};
+        DDS      triangle_dds{param};
+        DDSSweep repeat{{2000.0f, 1000.0f, 500, SweepShape::linear, SweepMode::repeat, CtrlFreq}};
+        DDSSweep triangle{{1000.0f, 2000.0f, 500, SweepShape::linear, SweepMode::triangle, CtrlFreq}};
+
+        repeat_dds.StartSweep(repeat);
+        triangle_dds.StartSweep(triangle);
+        for (int n = 0; n < 2000; n++) {
+            float out, shift_out;
+            repeat_dds.Calc(out, shift_out);
+            triangle_dds.Calc(out, shift_out);
+
+            // the frequency of sample n + 1
+            const int   k        = (n + 1) % 1000;
+            const float sawtooth = 2000.0f - 1000.0f * (float)(k % 500) / 500.0f;
+            const float tri      = (k < 500) ? 1000.0f + 2.0f * (float)k : 2000.0f - 2.0f * (float)(k - 500);
+            BOOST_TEST_REQUIRE(std::fabs(repeat_dds.GetFrequency() - sawtooth) < 1e-3f);
+            BOOST_TEST_REQUIRE(std::fabs(triangle_dds.GetFrequency() - tri) < 1e-3f);
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(dds_sweep_logarithmic) {
+        BOOST_TEST_MESSAGE("DDS: Logarithmic sweep follows the exponential within the segment approximation");
+
+        DDSParam param{true, 1.0f, 0.0f, 100.0f, 0.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT};
+        DDS      dds{param};
+        DDSSweep sweep{{100.0f, 10000.0f, 64000, SweepShape::logarithmic, SweepMode::single, CtrlFreq}};
+
+        dds.StartSweep(sweep);
+        double max_error = 0.0;
+        for (int n = 0; n < 64000; n++) {
+            float out, shift_out;
+            dds.Calc(out, shift_out);
+            const double expected = 100.0 * std::pow(100.0, (n + 1) / 64000.0);
+            max_error             = std::max(max_error, std::fabs((double)dds.GetFrequency() / expected - 1.0));
+        }
+        BOOST_TEST_MESSAGE("max. relative frequency error " << max_error);
+
+        // two decades in 32 segments: chord error (ln(100) / 32)^2 / 8 = 0.26 %
+        BOOST_TEST(max_error < 3e-3);
+        BOOST_TEST(std::fabs(dds.GetFrequency() - 10000.0f) < 1e-2f);
+    }
+
+    BOOST_AUTO_TEST_CASE(dds_sweep_block) {
+        BOOST_TEST_MESSAGE("DDS: CalcBlock while sweeping matches Calc");
+
+        DDSParam param{true, 0.5f, 0.1f, 1000.0f, 30.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT};
+        DDS      dds{param};
+        DDS      dds_block{param};
+        DDSSweep sweep{{1000.0f, 3000.0f, 300, SweepShape::logarithmic, SweepMode::triangle, CtrlFreq}};
+
+        dds.StartSweep(sweep);
+        dds_block.StartSweep(sweep);
+        float block[100];
+        for (int b = 0; b < 20; b++) {
+            dds_block.CalcBlock(block, 100);
+            for (float sample : block) {
+                float out, shift_out;
+                dds.Calc(out, shift_out);
+                BOOST_TEST_REQUIRE(bit_identical(sample, shift_out));
+            }
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(sinus_lut_grid) {
+        BOOST_TEST_MESSAGE("SinusLUT: Full-wave grid points by symmetry match std::sin");
+
+        for (uint32_t i = 0; i < (1u << SinusLUT<>::bits); i++) {
+            const double x = 2.0 * M_PI * i / (1u << SinusLUT<>::bits);
+            BOOST_TEST_REQUIRE(std::fabs((double)sinusLUT.Grid(i) - std::sin(x)) < 1e-7);
+        }
+        BOOST_TEST(sinusLUT.Grid(1u << (SinusLUT<>::bits - 2)) == 1.0f);
+        BOOST_TEST(sinusLUT.Grid(3u << (SinusLUT<>::bits - 2)) == -1.0f);
+    }
+
+    BOOST_AUTO_TEST_CASE(dds_integer_accumulator_float_reference) {
+        BOOST_TEST_MESSAGE("DDS: Integer phase accumulator matches the float LUT index over 10^7 samples");
+
+        const float freqs[]        = {20000.0f, 1234.5f, 7.0f, 49999.0f};
+        const float phaseOffsets[] = {0.0f, 10.0f, 45.0f};
+
+        for (auto freq : freqs) {
+            for (auto phaseOffset : phaseOffsets) {
+                DDSParam param{true, 1.5f, 0.25f, freq, phaseOffset, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT};
+                DDS      dds_int{param};
+                DDS      dds_float{param};
+
+                // float rounding of the interpolation; a phase off by one
+                // accumulator LSB differs by up to 2π / 2^16
+                float max_deviation = 0.0f;
+                for (long n = 0; n < 10000000; ++n) {
+                    float out_int, shift_int, out_float, shift_float;
+                    dds_int.Calc(out_int, shift_int);
+                    dds_float.CalcFloat(out_float, shift_float);
+                    max_deviation = std::max(max_deviation, std::fabs(out_int - out_float));
+                    max_deviation = std::max(max_deviation, std::fabs(shift_int - shift_float));
+                }
+                BOOST_TEST(max_deviation < 1e-6f, "freq " << freq << " phase offset " << phaseOffset);
+            }
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(dds_integer_accumulator_bit_identical) {
+        BOOST_TEST_MESSAGE("DDS: Integer phase accumulator is bit-identical to the integer phase model over 10^7 samples");
+
+        const float    freqs[]        = {20000.0f, 1234.5f, 7.0f, 49999.0f};
+        const float    phaseOffsets[] = {0.0f, 45.0f, 90.0f, 180.0f};
+        const uint32_t shifts[]       = {0, 1u << 29, 1u << 30, 1u << 31};
+
+        for (std::size_t k = 0; k < 4; k++) {
+            DDSParam   param{true, 1.5f, 0.25f, freqs[k], phaseOffsets[k], CtrlFreq, 16, SinusLUT<>::bits, sinusLUT};
+            DDS        dds{param};
+            DDSBank<1> bank;
+            bank.SetTone(0, param);
+
+            // the accumulator wraps around many times, for 7 Hz 700 times
+            uint32_t       phase      = 0;
+            const uint32_t step       = (uint32_t)DDS::TuningWord(freqs[k], CtrlFreq, 16) << 16;
+            long           mismatches = 0;
+            for (long n = 0; n < 10000000; ++n) {
+                float                out, shift_out;
+                std::array<float, 1> bank_out;
+                dds.Calc(out, shift_out);
+                bank.Calc(bank_out);
+                phase += step;
+                const bool identical = bit_identical(out, sinusLUT.Interp(phase))
+                                       && bit_identical(shift_out, sinusLUT.Interp(phase + shifts[k]) * 1.5f + 0.25f)
+                                       && bit_identical(bank_out[0], shift_out);
+                mismatches += identical ? 0 : 1;
+            }
+            BOOST_TEST(mismatches == 0, "freq " << freqs[k] << " phase offset " << phaseOffsets[k]);
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(dds_calc_phase) {
+        BOOST_TEST_MESSAGE("DDS: CalcPhase returns the shifted phase of Calc, its multiples are the harmonics");
+
+        // tuning and phase offset words of the second harmonic are exactly twice the fundamental's
+        const float freq = 809.0f * (float)CtrlFreq / 65536.0f;
+        DDSParam    param{true, 1.0f, 0.0f, freq, 45.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT};
+        DDSParam    param2{true, 1.0f, 0.0f, 2.0f * freq, 90.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT};
+        DDS         dds{param};
+        DDS         reference{param};
+        DDS         second{param2};
+        for (int n = 0; n < 100000; n++) {
+            const uint32_t phase = dds.CalcPhase();
+            float          out, shift_out, out2, shift_out2;
+            reference.Calc(out, shift_out);
+            second.Calc(out2, shift_out2);
+            BOOST_TEST_REQUIRE(sinusLUT.Interp(phase) == shift_out);
+            BOOST_TEST_REQUIRE(sinusLUT.Interp(2 * phase) == shift_out2);
+        }
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,185 @@
+/**
+ * @file test_fir.cpp
+ * @brief Unit tests for the FIR component.
+ * @copyright (c) 2021 TOPTICA Photonics AG
+ */
+#include <boost/test/unit_test.hpp>
+
+#include "fir.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(fir)
+
+    BOOST_AUTO_TEST_CASE(fir_convolution) {
+        BOOST_TEST_MESSAGE("Fir: Output equals the direct convolution, also across the buffer wrap");
+
+        const Fir<double, 7>::coefficients_t h{0.5, -0.25, 0.125, 1.0, 2.0, -3.0, 0.75};
+        Fir<double, 7>                       fir{h};
+
+        std::mt19937                     rng{42};
+        std::uniform_real_distribution<> dist{-1.0, 1.0};
+        std::deque<double>               history(7, 0.0);
+        for (int n = 0; n < 1000; n++) {
+            const double x = dist(rng);
+            history.push_front(x);
+            history.pop_back();
+
+            double expected = 0.0;
+            for (std::size_t k = 0; k < h.size(); k++) {
+                expected += h[k] * history[k];
+            }
+            BOOST_TEST_REQUIRE(fir.Calc(x) == expected, boost::test_tools::tolerance(1e-12));
+        }
+
+        fir.Reset();
+        double block[16] = {1.0};
+        fir.CalcBlock(block, block, 16);
+        for (std::size_t k = 0; k < 16; k++) {
+            BOOST_TEST(block[k] == ((k < h.size()) ? h[k] : 0.0));
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(boxcar_integer_exact) {
+        BOOST_TEST_MESSAGE("Boxcar: Integer average is exact");
+
+        Boxcar<int32_t, 64> boxcar{50};
+        BOOST_TEST(boxcar.Length() == 50u);
+
+        std::mt19937                           rng{1};
+        std::uniform_int_distribution<int32_t> dist{-1000000, 1000000};
+        std::deque<int64_t>                    history(50, 0);
+        int64_t                                sum = 0;
+        for (int n = 0; n < 1000000; n++) {
+            const int32_t x = dist(rng);
+            sum += x - history.back();
+            history.pop_back();
+            history.push_front(x);
+            BOOST_TEST_REQUIRE(boxcar.Calc(x) == (int32_t)(sum / 50));
+        }
+
+        boxcar.SetLength(1000);
+        BOOST_TEST(boxcar.Length() == 64u);
+    }
+
+    BOOST_AUTO_TEST_CASE(boxcar_float_no_drift) {
+        BOOST_TEST_MESSAGE("Boxcar: Float running sum does not drift over 10^7 samples");
+
+        Boxcar<float, 128> boxcar{50};
+
+        std::mt19937                          rng{7};
+        std::uniform_real_distribution<float> dist{-1.0f, 1.0f};
+        std::deque<float>                     history(50, 0.0f);
+        float                                 naive           = 0.0f;
+        double                                max_error       = 0.0;
+        double                                max_naive_error = 0.0;
+        for (int n = 0; n < 10000000; n++) {
+            // a large offset, like the DC part of the demodulated signal
+            const float x = 100.0f + dist(rng);
+            naive += x - history.back();
+            history.pop_back();
+            history.push_front(x);
+
+            const float out = boxcar.Calc(x);
+            if (n % 100000 == 99999) {
+                double exact = 0.0;
+                for (float h : history) {
+                    exact += (double)h;
+                }
+                exact /= 50.0;
+                max_error       = std::max(max_error, std::fabs((double)out - exact));
+                max_naive_error = std::max(max_naive_error, std::fabs((double)(naive / 50.0f) - exact));
+            }
+        }
+        BOOST_TEST_MESSAGE("max. error " << max_error << ", uncompensated " << max_naive_error);
+        BOOST_TEST(max_error < 2e-5); // float resolution at 100
+        BOOST_TEST(max_error < max_naive_error);
+    }
+
+    BOOST_AUTO_TEST_CASE(fir_decimator_equals_filter_then_drop) {
+        BOOST_TEST_MESSAGE("FirDecimator: Output equals every Factor-th output of the full-rate Fir");
+
+        Fir<double, 24>::coefficients_t h{};
+        std::mt19937                     rng{3};
+        std::uniform_real_distribution<> dist{-1.0, 1.0};
+        for (auto& c : h) {
+            c = dist(rng);
+        }
+        Fir<double, 24>             fir{h};
+        FirDecimator<double, 24, 5> decimator{h};
+
+        std::vector<double> in(1003);
+        for (auto& x : in) {
+            x = dist(rng);
+        }
+
+        // per sample
+        std::vector<double> expected;
+        for (std::size_t n = 0; n < in.size(); n++) {
+            const double full = fir.Calc(in[n]);
+            if (n % 5 == 4) {
+                expected.push_back(full);
+            }
+            double out;
+            if (decimator.Calc(in[n], out)) {
+                BOOST_TEST_REQUIRE(out == full, boost::test_tools::tolerance(1e-12));
+            } else {
+                BOOST_TEST_REQUIRE(n % 5 != 4);
+            }
+        }
+
+        // in blocks of odd sizes, the phase carries over between blocks
+        decimator.Reset();
+        std::vector<double> out(in.size());
+        std::size_t         outputs = 0;
+        for (std::size_t n = 0; n < in.size(); n += 7) {
+            const std::size_t block = std::min<std::size_t>(7, in.size() - n);
+            outputs += decimator.CalcBlock(&in[n], &out[outputs], block);
+        }
+        BOOST_TEST_REQUIRE(outputs == expected.size());
+        for (std::size_t k = 0; k < outputs; k++) {
+            BOOST_TEST_REQUIRE(out[k] == expected[k], boost::test_tools::tolerance(1e-12));
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(fir_interpolator_equals_zero_stuffed_filter) {
+        BOOST_TEST_MESSAGE("FirInterpolator: Output equals the Fir fed with the zero-stuffed input");
+
+        // 23 taps do not divide into 4 phases, the last phase is zero padded
+        Fir<double, 23>::coefficients_t h{};
+        std::mt19937                     rng{5};
+        std::uniform_real_distribution<> dist{-1.0, 1.0};
+        for (auto& c : h) {
+            c = dist(rng);
+        }
+        Fir<double, 23>                fir{h};
+        FirInterpolator<double, 23, 4> interpolator{h};
+
+        std::vector<double> in(500);
+        for (auto& x : in) {
+            x = dist(rng);
+        }
+
+        std::vector<double> out(in.size() * 4);
+        interpolator.CalcBlock(in.data(), out.data(), in.size());
+        for (std::size_t n = 0; n < in.size(); n++) {
+            for (std::size_t p = 0; p < 4; p++) {
+                const double expected = fir.Calc((p == 0) ? in[n] : 0.0);
+                BOOST_TEST_REQUIRE(out[n * 4 + p] == expected, boost::test_tools::tolerance(1e-12));
+            }
+        }
+
+        interpolator.Reset();
+        double impulse[4];
+        interpolator.Calc(1.0, impulse);
+        for (std::size_t p = 0; p < 4; p++) {
+            BOOST_TEST(impulse[p] == h[p]);
+        }
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
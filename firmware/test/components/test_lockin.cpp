@@ -0,0 +1,270 @@
+/**
+ * @file test_lockin.cpp
+ * @brief Unit tests for the LockIn component.
+ * @copyright (c) 2021 TOPTICA Photonics AG
+ */
+#include <boost/test/unit_test.hpp>
+
+#include "fastMath.hpp"
+#include "harmonicLockIn.hpp"
+#include "lockIn.hpp"
+#include "peripherals.hpp"
+#include "sinusLUT.hpp"
+#include "slidingDft.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <random>
+
+BOOST_AUTO_TEST_SUITE(lockin)
+
+    BOOST_AUTO_TEST_CASE(fast_sqrt_error_bound) {
+        BOOST_TEST_MESSAGE("fast_math::sqrt: Relative error within its bound over the float range");
+
+        double max_error = 0.0;
+        for (float x = 1e-30f; x < 1e30f; x *= 1.0001f) {
+            const double exact = std::sqrt((double)x);
+            max_error          = std::max(max_error, std::fabs((double)fast_math::sqrt(x) - exact) / exact);
+        }
+        BOOST_TEST_MESSAGE("max. relative error " << max_error);
+        BOOST_TEST(max_error < fast_math::SQRT_MAX_RELATIVE_ERROR);
+        BOOST_TEST(fast_math::sqrt(0.0f) == 0.0f);
+        BOOST_TEST(fast_math::sqrt(-1.0f) == 0.0f);
+    }
+
+    BOOST_AUTO_TEST_CASE(fast_atan2_error_bound) {
+        BOOST_TEST_MESSAGE("fast_math::atan2: Error within its bound in all quadrants");
+
+        double max_error = 0.0;
+        for (int n = 0; n < 1000000; n++) {
+            const double angle = -M_PI + 2.0 * M_PI * (n + 0.5) / 1000000.0;
+            for (float r : {1e-20f, 1.0f, 3e20f}) {
+                const float  x     = r * (float)std::cos(angle);
+                const float  y     = r * (float)std::sin(angle);
+                const double exact = std::atan2((double)y, (double)x);
+                max_error          = std::max(max_error, std::fabs((double)fast_math::atan2(y, x) - exact));
+            }
+        }
+        BOOST_TEST_MESSAGE("max. error " << max_error << " rad");
+        BOOST_TEST(max_error < fast_math::ATAN2_MAX_ERROR);
+        BOOST_TEST(fast_math::atan2(0.0f, 0.0f) == 0.0f);
+        BOOST_TEST(fast_math::atan2(0.0f, -1.0f) == fast_math::PI);
+        BOOST_TEST(fast_math::atan2(1.0f, 0.0f) == 0.5f * fast_math::PI);
+        BOOST_TEST(fast_math::atan2(-1.0f, 0.0f) == -0.5f * fast_math::PI);
+    }
+
+    BOOST_AUTO_TEST_CASE(lockin_iq_magnitude_and_phase) {
+        BOOST_TEST_MESSAGE("LockIn: R and theta of a tone independent of the reference phase offset");
+
+        // 64 samples per period, the boxcar spans two periods and removes the 2f part
+        const float  freq = (float)CtrlFreq / 64.0f;
+        const double lag  = 30.0 * M_PI / 180.0; // signal lags the unshifted reference
+        const double amp  = 2.0;
+        for (float phaseOffset : {0.0f, 45.0f, 120.0f, 270.0f}) {
+            DDSParam param{true, 1.0f, 0.0f, freq, phaseOffset, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT};
+            LockIn   lockIn{param, freq / 2.0f, 100};
+
+            // the DDS advances its phase before the first sample
+            LockInIQ out{};
+            for (int n = 1; n <= 1000; n++) {
+                out = lockIn.LockIn_runIQ((float)(amp * std::sin(2.0 * M_PI * n / 64.0 - lag)));
+            }
+
+            // mean of sin(a) sin(b), sin(a) cos(b): cos(a - b) / 2, sin(a - b) / 2
+            const double theta = std::remainder(-lag - (double)phaseOffset * M_PI / 180.0, 2.0 * M_PI);
+            BOOST_TEST_MESSAGE("offset " << phaseOffset << "°: R " << out.r << ", theta " << out.theta);
+            BOOST_TEST(std::fabs((double)out.r - amp / 2.0) < 1e-3);
+            BOOST_TEST(std::fabs(std::remainder((double)out.theta - theta, 2.0 * M_PI)) < 1e-3);
+            BOOST_TEST(std::fabs((double)out.x - amp / 2.0 * std::cos(theta)) < 1e-3);
+            BOOST_TEST(std::fabs((double)out.y - amp / 2.0 * std::sin(theta)) < 1e-3);
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(lockin_iq_dc_and_reference_offset) {
+        BOOST_TEST_MESSAGE("LockIn: R and theta independent of DDS amplitude, offset and DC level of the input");
+
+        const float  freq = (float)CtrlFreq / 64.0f;
+        const double lag  = 30.0 * M_PI / 180.0;
+        const double amp  = 0.5;
+        const double dc   = 1.2; // photodiode level
+        for (float ddsAmp : {1.0f, 0.25f}) {
+            DDSParam param{true, ddsAmp, ddsAmp, freq, 0.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT};
+            LockIn   lockIn{param, freq / 2.0f, 100};
+
+            LockInIQ out{};
+            for (int n = 1; n <= 1000; n++) {
+                out = lockIn.LockIn_runIQ((float)(dc + amp * std::sin(2.0 * M_PI * n / 64.0 - lag)));
+            }
+
+            BOOST_TEST_MESSAGE("amplitude and offset " << ddsAmp << ": R " << out.r << ", theta " << out.theta);
+            BOOST_TEST(std::fabs((double)out.r - amp / 2.0) < 1e-3);
+            BOOST_TEST(std::fabs((double)out.theta + lag) < 1e-3);
+            BOOST_TEST(std::fabs((double)out.x - amp / 2.0 * std::cos(lag)) < 1e-3);
+            BOOST_TEST(std::fabs((double)out.y + amp / 2.0 * std::sin(lag)) < 1e-3);
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(lockin_fir_length) {
+        BOOST_TEST_MESSAGE("LockIn: Boxcar of one period down to the lowest FIR frequency");
+
+        DDSParam param{true, 1.0f, 0.0f, 1000.0f, 0.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT};
+        for (float FIRfreq : {2000.0f, 500.0f, 100.0f}) {
+            LockIn lockIn{param, FIRfreq, 100};
+            BOOST_TEST(lockIn.fir.Length() == (std::size_t)std::lround((float)CtrlFreq / FIRfreq));
+            BOOST_TEST(lockIn.firQ.Length() == lockIn.fir.Length());
+        }
+        BOOST_TEST((float)CtrlFreq / (float)FIR_MAX_LENGTH <= 100.0f);
+    }
+
+    BOOST_AUTO_TEST_CASE(lockin_cic_resolution) {
+        BOOST_TEST_MESSAGE("LockIn: One ADC LSB step of the demodulated signal survives the CIC decimation");
+
+        const double lsb = (double)PDMaxVolt / 65535.0;
+        for (double reference : {1.0, (double)DDS_MAX_OUTPUT}) {
+            for (double level : {0.0, 1.2, (double)PDMaxVolt - lsb}) {
+                Cic<CIC_ORDER> cic{(uint32_t)100, CIC_FULL_SCALE};
+                float          low  = 0.0f;
+                float          high = 0.0f;
+                for (int n = 0; n < 1000; n++) {
+                    cic.Calc((float)(level * reference), low);
+                }
+                for (int n = 0; n < 1000; n++) {
+                    cic.Calc((float)((level + lsb) * reference), high);
+                }
+                BOOST_TEST(std::fabs((double)(high - low) - lsb * reference) < 0.01 * lsb * reference);
+            }
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(harmonic_lockin) {
+        BOOST_TEST_MESSAGE("HarmonicLockIn: Amplitude and phase of 1f, 2f and 3f from one reference");
+
+        // 64 samples per period of the fundamental, all products are harmonics of it
+        const float  freq         = (float)CtrlFreq / 64.0f;
+        const double amplitude[3] = {1.0, 0.5, 0.25};
+        const double phase[3]     = {0.3, -0.5, 1.0};
+
+        DDSParam       param{true, 1.0f, 0.0f, freq, 0.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT};
+        const uint32_t harmonics[] = {1, 2, 3};
+        HarmonicLockIn lockIn{param, freq / 2.0f, harmonics, 3};
+        BOOST_TEST(lockIn.Harmonics() == 3u);
+
+        // the DDS advances its phase before the first sample
+        int  n   = 0;
+        auto run = [&] {
+            for (int end = n + 1000; n < end;) {
+                n++;
+                double s = 0.0;
+                for (int h = 0; h < 3; h++) {
+                    s += amplitude[h] * std::sin((h + 1) * 2.0 * M_PI * n / 64.0 + phase[h]);
+                }
+                lockIn.Run((float)s);
+            }
+        };
+        run();
+        for (std::size_t h = 0; h < 3; h++) {
+            const auto out = lockIn.Output(h);
+            BOOST_TEST_MESSAGE(lockIn.Harmonic(h) << "f: R " << out.r << ", theta " << out.theta);
+            BOOST_TEST(std::fabs((double)out.r - amplitude[h] / 2.0) < 1e-4);
+            BOOST_TEST(std::fabs((double)out.theta - phase[h]) < 1e-3);
+        }
+
+        // only the second harmonic, e.g. for peak locking
+        const uint32_t second[] = {2};
+        lockIn.SetHarmonics(second, 1);
+        run();
+        BOOST_TEST(lockIn.Harmonics() == 1u);
+        BOOST_TEST(std::fabs((double)lockIn.Output(0).r - amplitude[1] / 2.0) < 1e-4);
+        BOOST_TEST(std::fabs((double)lockIn.Output(0).theta - phase[1]) < 1e-3);
+    }
+
+    BOOST_AUTO_TEST_CASE(sliding_dft_tones) {
+        BOOST_TEST_MESSAGE("SlidingDft: Amplitude and phase of tones on whole periods of the window");
+
+        // 64 samples per period of the fundamental, the window spans two periods
+        const double  amplitude[2] = {1.0, 0.5};
+        const double  phase[2]     = {0.3, -0.5};
+        const float   freq         = (float)CtrlFreq / 64.0f;
+        SlidingDft<3> dft{sinusLUT, 2.0f, 128};
+        dft.SetBin(0, freq);
+        dft.SetBin(1, 2.0f * freq);
+        dft.SetBin(2, 4.0f * freq); // no signal
+        BOOST_TEST(dft.BinStep(0) == 1u << 26);
+
+        // the bins advance their phase before the first sample
+        for (int n = 1; n <= 1000; n++) {
+            double s = 0.0;
+            for (int h = 0; h < 2; h++) {
+                s += amplitude[h] * std::sin((h + 1) * 2.0 * M_PI * n / 64.0 + phase[h]);
+            }
+            dft.Calc((float)s);
+        }
+        for (std::size_t h = 0; h < 2; h++) {
+            const auto out = dft.Output(h);
+            BOOST_TEST_MESSAGE("bin " << h << ": R " << out.r << ", theta " << out.theta);
+            BOOST_TEST(std::fabs((double)out.r - amplitude[h] / 2.0) < 1e-4);
+            BOOST_TEST(std::fabs((double)out.theta - phase[h]) < 1e-3);
+        }
+        BOOST_TEST(dft.Output(2).r < 1e-5f);
+    }
+
+    BOOST_AUTO_TEST_CASE(sliding_dft_equals_dft_of_window) {
+        BOOST_TEST_MESSAGE("SlidingDft: Equals the DFT of the last samples, without drift, at any bin");
+
+        const std::size_t length = 100;
+        SlidingDft<2>     dft{sinusLUT, 128.0f, length};
+        dft.SetBin(0, 50.0f);
+        dft.SetBin(1, 1234.5f);
+        std::array<uint32_t, 2> phase{};
+
+        std::mt19937                          rng{17};
+        std::uniform_real_distribution<float> dist{-1.0f, 1.0f};
+        std::deque<float>                     window;
+
+        // direct sums over the window with the table references, the newest
+        // sample has the reference phase phase[k]
+        auto check = [&] {
+            for (std::size_t k = 0; k < 2; k++) {
+                double x = 0.0;
+                double y = 0.0;
+                for (std::size_t age = 0; age < window.size(); age++) {
+                    float sin, cos;
+                    sinusLUT.InterpIQ(phase[k] - dft.BinStep(k) * (uint32_t)age, sin, cos);
+                    x += (double)window[window.size() - 1 - age] * (double)sin;
+                    y += (double)window[window.size() - 1 - age] * (double)cos;
+                }
+                // a few float rounding steps of the mean, no drift
+                const auto out = dft.Output(k);
+                x /= (double)length;
+                y /= (double)length;
+                BOOST_TEST(std::fabs((double)out.x - x) < 1e-6 + 2.5e-7 * std::fabs(x));
+                BOOST_TEST(std::fabs((double)out.y - y) < 1e-6 + 2.5e-7 * std::fabs(y));
+            }
+        };
+        auto run = [&](int samples) {
+            for (int n = 0; n < samples; n++) {
+                const float in = dist(rng) + 100.0f; // large offset to provoke drift
+                dft.Calc(in);
+                window.push_back(in);
+                if (window.size() > length) {
+                    window.pop_front();
+                }
+                for (std::size_t k = 0; k < 2; k++) {
+                    phase[k] += dft.BinStep(k);
+                }
+            }
+        };
+
+        run(1000000);
+        check();
+
+        // retuning a bin recomputes it from the buffered input
+        dft.SetBin(1, 20000.0f);
+        check();
+        run(1000);
+        check();
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,135 @@
+/**
+ * @file test_mailbox.cpp
+ * @brief Stress tests of the parameter mailbox with real threads, built
+ * with ThreadSanitizer, see test/CMakeLists.txt.
+ * @copyright (c) 2021 TOPTICA Photonics AG
+ */
+#include <boost/test/unit_test.hpp>
+
+#include "channelEngine.hpp"
+#include "ddsBank.hpp"
+#include "mailbox.hpp"
+#include "sinusLUT.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace {
+// parameter set whose fields all derive from one sequence number, so a torn
+// set is detected by any field disagreeing with the others
+struct Set
+{
+    uint32_t                 sequence;
+    std::array<float, 61>    values;
+    std::array<uint32_t, 64> words;
+};
+
+Set make_set(uint32_t sequence)
+{
+    Set set;
+    set.sequence = sequence;
+    for (std::size_t k = 0; k < set.values.size(); k++) {
+        set.values[k] = (float)sequence + (float)k;
+    }
+    for (std::size_t k = 0; k < set.words.size(); k++) {
+        set.words[k] = sequence ^ (uint32_t)(k * 0x9e3779b9u);
+    }
+    return set;
+}
+
+bool consistent(const Set& set)
+{
+    return set.sequence == make_set(set.sequence).sequence && set.values == make_set(set.sequence).values
+           && set.words == make_set(set.sequence).words;
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(mailbox)
+
+    BOOST_AUTO_TEST_CASE(mailbox_no_torn_sets) {
+        BOOST_TEST_MESSAGE("Mailbox: Receiver only sees whole sets, in order, and finally the last one");
+
+        const uint32_t    n_sets = 200000;
+        Mailbox<Set>      box{make_set(0)};
+        std::atomic<bool> done{false};
+
+        std::thread sender([&] {
+            for (uint32_t k = 1; k <= n_sets; k++) {
+                box.Send(make_set(k));
+            }
+            done.store(true, std::memory_order_release);
+        });
+
+        // receiver as the control tick: poll, apply if new
+        uint32_t last     = 0;
+        uint32_t received = 0;
+        bool     torn     = false;
+        bool     ordered  = true;
+        auto     apply    = [&](const Set& set) {
+            torn    = torn || !consistent(set);
+            ordered = ordered && set.sequence > last;
+            last    = set.sequence;
+            received++;
+        };
+        while (!done.load(std::memory_order_acquire)) {
+            box.Receive(apply);
+        }
+        sender.join();
+        box.Receive(apply);
+
+        BOOST_TEST(!torn);
+        BOOST_TEST(ordered);
+        BOOST_TEST(last == n_sets);
+        BOOST_TEST(received > 0u);
+        BOOST_TEST_MESSAGE("received " << received << " of " << n_sets << " sets");
+        // nothing new after the last set
+        BOOST_TEST(!box.Receive(apply));
+    }
+
+    BOOST_AUTO_TEST_CASE(mailbox_engine_param) {
+        BOOST_TEST_MESSAGE("Mailbox: Engine parameter sets applied at tick boundaries while the engine runs");
+
+        PIDParam pid{1.0f, 100.0f, 0.0f, 0.5f, 10.0f, 0.0f};
+        DDSParam dds{true, 1.0f, 0.0f, 20000.0f, 0.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT};
+        using engine_t = ChannelEngine<3>;
+        engine_t engine{pid, dds, 2000.0f};
+
+        Mailbox<engine_t::param_t> box;
+        std::atomic<bool>          done{false};
+
+        std::thread sender([&] {
+            for (int k = 1; k <= 20000; k++) {
+                PIDParam gains{1.0f + (float)k, 100.0f, 0.0f, 0.5f, 10.0f, (float)k};
+                DDSParam tone{true, (float)k, 0.0f, 10000.0f + (float)k, 0.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT};
+                auto     param = engine_t::Param(gains, dds, (k % 2 == 0) ? 2000.0f : 4000.0f);
+                param.tone[1]  = DDSBank<3>::Tone(tone);
+                box.Send(param);
+            }
+            done.store(true, std::memory_order_release);
+        });
+
+        bool     consistentSets = true;
+        uint32_t applied        = 0;
+        auto     apply          = [&](const engine_t::param_t& param) {
+            const float k  = param.pid[0].kds;
+            consistentSets = consistentSets && param.pid[2].kpf == 1.0f + k && param.tone[1].amp == k;
+            engine.ApplyFast(param);
+            engine.ApplySlow(param);
+            applied++;
+        };
+        engine_t::channels_t error{0.1f, -0.2f, 0.3f};
+        while (!done.load(std::memory_order_acquire)) {
+            box.Receive(apply);
+            engine_t::channels_t sctrl, fctrl;
+            engine.step(error, sctrl, fctrl);
+        }
+        sender.join();
+        box.Receive(apply);
+
+        BOOST_TEST(consistentSets);
+        BOOST_TEST(applied > 0u);
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
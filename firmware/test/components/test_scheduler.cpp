@@ -0,0 +1,221 @@
+/**
+ * @file test_scheduler.cpp
+ * @brief Unit tests for the Scheduler component.
+ * @copyright (c) 2021 TOPTICA Photonics AG
+ */
+#include <boost/test/unit_test.hpp>
+
+#include "channelEngine.hpp"
+#include "deferred.hpp"
+#include "rateScheduler.hpp"
+#include "sinusLUT.hpp"
+#include "tripleBuffer.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+// host stand-in for the cycle counter: every task run costs what it adds
+struct FakeClock
+{
+    static uint32_t Now()
+    {
+        return now;
+    }
+    static inline uint32_t now = 0;
+};
+
+// host stand-in for PendSV: the simulation runs the slow-loop interrupt
+// once the control interrupt has returned
+struct SimTrigger
+{
+    static void Pend()
+    {
+        pending = true;
+    }
+    static inline bool pending = false;
+};
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(scheduler)
+
+    BOOST_AUTO_TEST_CASE(rate_groups_valid) {
+        BOOST_TEST_MESSAGE("RateGroupsValid: Slow groups must not share a tick");
+
+        static_assert(RateGroupsValid(std::array<RateGroup, 3>{{{1, 0, 0}, {4, 1, 0}, {6, 0, 0}}}));
+        // 4 and 6 meet where the phases agree modulo 2
+        static_assert(!RateGroupsValid(std::array<RateGroup, 3>{{{1, 0, 0}, {4, 1, 0}, {6, 3, 0}}}));
+        // coprime divisors always meet
+        static_assert(!RateGroupsValid(std::array<RateGroup, 2>{{{3, 0, 0}, {5, 1, 0}}}));
+        // the fast path runs with every slow group
+        static_assert(RateGroupsValid(std::array<RateGroup, 3>{{{1, 0, 0}, {1, 0, 0}, {2, 1, 0}}}));
+        BOOST_TEST(!RateGroupsValid(std::array<RateGroup, 1>{{{0, 0, 0}}}));
+        BOOST_TEST(!RateGroupsValid(std::array<RateGroup, 1>{{{4, 4, 0}}}));
+    }
+
+    BOOST_AUTO_TEST_CASE(rate_scheduler_rates_and_phases) {
+        BOOST_TEST_MESSAGE("RateScheduler: Tasks run at their divisor and phase, fast path first");
+
+        std::vector<int> trace;
+        int              tick = 0;
+        auto             scheduler = MakeRateScheduler<FakeClock>(
+            std::array<RateGroup, 3>{{{1, 0, 0}, {10, 9, 0}, {10, 4, 0}}},
+            [&] { trace.push_back(0); },
+            [&] { trace.push_back(1); BOOST_TEST(tick % 10 == 9); },
+            [&] { trace.push_back(2); BOOST_TEST(tick % 10 == 4); });
+
+        for (tick = 0; tick < 100; tick++) {
+            const auto before = trace.size();
+            scheduler.Tick();
+            BOOST_TEST_REQUIRE(trace[before] == 0);
+            // never two slow tasks on one tick
+            BOOST_TEST_REQUIRE(trace.size() - before <= 2u);
+        }
+        // the slow task completes exactly once per 10 ticks, not 11
+        BOOST_TEST(scheduler.Stats(0).runs == 100u);
+        BOOST_TEST(scheduler.Stats(1).runs == 10u);
+        BOOST_TEST(scheduler.Stats(2).runs == 10u);
+    }
+
+    BOOST_AUTO_TEST_CASE(rate_scheduler_budgets) {
+        BOOST_TEST_MESSAGE("RateScheduler: Run time per task against its budget");
+
+        uint32_t cost      = 100;
+        auto     scheduler = MakeRateScheduler<FakeClock>(
+            std::array<RateGroup, 2>{{{1, 0, 150}, {2, 0, 0}}},
+            [&] { FakeClock::now += cost; },
+            [&] { FakeClock::now += 1000; });
+
+        scheduler.Tick();
+        cost = 200;
+        scheduler.Tick();
+        scheduler.Tick();
+        BOOST_TEST(scheduler.Stats(0).runs == 3u);
+        BOOST_TEST(scheduler.Stats(0).lastCycles == 200u);
+        BOOST_TEST(scheduler.Stats(0).maxCycles == 200u);
+        BOOST_TEST(scheduler.Stats(0).overruns == 2u);
+        // no budget, no overruns
+        BOOST_TEST(scheduler.Stats(1).runs == 2u);
+        BOOST_TEST(scheduler.Stats(1).maxCycles == 1000u);
+        BOOST_TEST(scheduler.Stats(1).overruns == 0u);
+
+        scheduler.ResetStats();
+        BOOST_TEST(scheduler.Stats(0).runs == 0u);
+    }
+
+    BOOST_AUTO_TEST_CASE(triple_buffer_latest_value) {
+        BOOST_TEST_MESSAGE("TripleBuffer: Consumer gets the latest published value, once");
+
+        TripleBuffer<int> buffer{-1};
+        BOOST_TEST(!buffer.Consume());
+        BOOST_TEST(buffer.Read() == -1);
+
+        buffer.Publish(1);
+        BOOST_TEST(buffer.Consume());
+        BOOST_TEST(buffer.Read() == 1);
+        BOOST_TEST(!buffer.Consume());
+        BOOST_TEST(buffer.Read() == 1);
+
+        // overwritten before consumed
+        buffer.Publish(2);
+        buffer.Write() = 3;
+        buffer.Publish();
+        BOOST_TEST(buffer.Consume());
+        BOOST_TEST(buffer.Read() == 3);
+
+        // the read slot stays valid while the producer goes on
+        for (int k = 4; k < 10; k++) {
+            buffer.Publish(k);
+            BOOST_TEST_REQUIRE(buffer.Read() == 3);
+        }
+        BOOST_TEST(buffer.Consume());
+        BOOST_TEST(buffer.Read() == 9);
+    }
+
+    // Two interrupt priorities: the control interrupt ticks the fast path
+    // and posts the decimated samples, the slow-loop interrupt runs the slow
+    // PIDs whenever pended and is preempted by control ticks at random
+    // points of its work, also between taking the sample and using it.
+    void simulate_two_levels(int maxPreemption, uint32_t& dropped)
+    {
+        PIDParam pid{1.0f, 100.0f, 1e-5f, 0.5f, 10.0f, 0.0f};
+        DDSParam dds{true, 1.0f, 1.0f, 20000.0f, 0.0f, CtrlFreq, 16, SinusLUT<>::bits, sinusLUT};
+
+        ChannelEngine<3> reference{pid, dds, 2000.0f};
+        ChannelEngine<3> engine{pid, dds, 2000.0f};
+        using channels_t = ChannelEngine<3>::channels_t;
+        Deferred<channels_t, SimTrigger> slow;
+
+        std::mt19937                          rng{19};
+        std::uniform_real_distribution<float> dist{-1.0f, 1.0f};
+        std::uniform_int_distribution<int>    preemption{0, maxPreemption};
+        std::vector<channels_t>               expectedSlow, slowOut;
+
+        const int n_ticks = 20000;
+        int       n       = 0;
+        auto      control = [&] {
+            channels_t error;
+            for (auto& e : error) {
+                e = dist(rng);
+            }
+            channels_t sctrl, fctrl, fast;
+            reference.step(error, sctrl, fctrl);
+            if (n % CountLim == CountLim - 1) {
+                expectedSlow.push_back(sctrl);
+            }
+
+            engine.stepFast(error, fast);
+            BOOST_TEST_REQUIRE(std::memcmp(&fctrl, &fast, sizeof(fast)) == 0);
+            channels_t slowSig;
+            if (n % CountLim == CountLim - 1 && engine.TakeSlowSignal(slowSig)) {
+                slow.Post(slowSig);
+            }
+            n++;
+        };
+        auto preempt = [&] {
+            for (int k = preemption(rng); k > 0 && n < n_ticks; k--) {
+                control();
+            }
+        };
+
+        SimTrigger::pending = false;
+        while (n < n_ticks) {
+            control();
+            if (SimTrigger::pending) {
+                SimTrigger::pending = false;
+                slow.Run([&](const channels_t& slowSig) {
+                    preempt();
+                    channels_t sctrl;
+                    engine.runSlow(slowSig, sctrl);
+                    preempt();
+                    slowOut.push_back(sctrl);
+                });
+            }
+        }
+
+        dropped = slow.Dropped();
+        if (dropped == 0) {
+            BOOST_TEST_REQUIRE(slowOut.size() == expectedSlow.size());
+            for (std::size_t k = 0; k < slowOut.size(); k++) {
+                BOOST_TEST_REQUIRE(std::memcmp(&slowOut[k], &expectedSlow[k], sizeof(channels_t)) == 0);
+            }
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(two_level_execution) {
+        BOOST_TEST_MESSAGE("Deferred: Slow loop preempted by the control interrupt equals the single-level loop");
+
+        uint32_t dropped;
+        // slow work within one slow period: nothing lost, same results
+        simulate_two_levels(CountLim / 2 - 1, dropped);
+        BOOST_TEST(dropped == 0u);
+        // slow work overrunning its period: samples are dropped, the fast
+        // path is unaffected (checked every tick)
+        simulate_two_levels(2 * CountLim, dropped);
+        BOOST_TEST(dropped > 0u);
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,15 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+/*
+ * Host stand-in for the target peripherals.hpp: the timing constants of the
+ * control loop, without the HAL, so the components using them compile in
+ * the host tests.
+ */
+namespace {
+const uint16_t LDCHNs    = 3;     // LD channel numbers
+const uint32_t MainFreq  = 200e6; // µC main frequency [Hz]
+const uint32_t CtrlFreq  = 100e3; // loop frequency [Hz]
+const float    PDMaxVolt = 2.45f; // photodiode signal at ADC full scale [V]
+} // namespace
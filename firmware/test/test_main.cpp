@@ -0,0 +1,7 @@
+/**
+ * @file test_main.cpp
+ * @brief Main file for the CBC firmware host unit tests.
+ * @copyright (c) 2021 TOPTICA Photonics AG
+ */
+#define BOOST_TEST_MODULE CBC_Firmware_Unit_Tests // NOLINT(cppcoreguidelines-macro-usage)
+#include <boost/test/unit_test.hpp>
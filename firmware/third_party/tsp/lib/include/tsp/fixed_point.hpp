@@ -0,0 +1,308 @@
+/*******************************************************************************
+ *
+ * @copyright   TOPTICA Photonics AG
+ * @date        2026
+ *
+ * @file        fixed_point.hpp
+ * @brief       Fixed-point numbers with saturating arithmetic.
+ *
+ * @author      agent <agent@local>
+ *
+ ******************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace toptica::tsp::fixed_point {
+
+namespace detail {
+
+template <typename Storage>
+struct wide;
+template <>
+struct wide<std::int16_t>
+{
+    using type = std::int32_t;
+};
+template <>
+struct wide<std::int32_t>
+{
+    using type = std::int64_t;
+};
+
+} // namespace detail
+
+/*******************************************************************************
+ * @class fixed
+ *
+ * @brief A signed fixed-point number in Q format with saturating arithmetic.
+ *
+ * @details
+ *     The value is `raw / 2^FractionalBits`, stored in @p Storage; the
+ *     remaining bits but the sign are integer bits, e.g. fixed<15,
+ *     std::int16_t> is Q15 in [-1, 1) and fixed<24> is Q7.24 in [-128, 128).
+ *     Every operation saturates at fixed::lowest and fixed::max instead of
+ *     wrapping around.  Products and quotients are computed in the double
+ *     width of @p Storage and rounded to nearest, so a multiply-accumulate
+ *     rounds and saturates each product and each sum.  Results do not depend
+ *     on the platform: the same inputs give the same bits on the host and on
+ *     the target.
+ *
+ *     Conversions from and to floating-point are meant for configuration
+ *     and tests; on the signal path use fixed::from_raw and fixed::raw, e.g.
+ *     for ADC and DAC codes.
+ *
+ * @tparam FractionalBits   Number of fractional bits.
+ * @tparam Storage          Signed integer type, std::int16_t or std::int32_t.
+ ******************************************************************************/
+template <int FractionalBits, typename Storage = std::int32_t>
+class fixed
+{
+    static_assert(std::is_same<Storage, std::int16_t>::value || std::is_same<Storage, std::int32_t>::value,
+                  "Only 16 and 32 bit storage is supported!");
+    static_assert(FractionalBits > 0 && FractionalBits < std::numeric_limits<Storage>::digits + 1,
+                  "The fractional bits must fit into the storage!");
+
+  public:
+    using storage_t = Storage;
+    using wide_t    = typename detail::wide<Storage>::type;
+
+    static constexpr int fractional_bits{FractionalBits};
+
+    constexpr fixed() = default;
+
+    /***************************************************************************
+     * @brief               Converts an integer or floating-point value,
+     *                      rounded to nearest and saturated.
+     **************************************************************************/
+    template <typename V, typename = std::enable_if_t<std::is_arithmetic<V>::value>>
+    constexpr fixed(V value) // NOLINT(google-explicit-constructor): like a built-in number
+      : m_raw{m_from(value)}
+    {
+    }
+
+    static constexpr fixed from_raw(Storage raw)
+    {
+        fixed value;
+        value.m_raw = raw;
+        return value;
+    }
+
+    constexpr Storage raw() const
+    {
+        return m_raw;
+    }
+
+    template <typename V, typename = std::enable_if_t<std::is_floating_point<V>::value>>
+    explicit constexpr operator V() const
+    {
+        return static_cast<V>(m_raw) / static_cast<V>(m_one);
+    }
+
+    static constexpr fixed lowest()
+    {
+        return from_raw(std::numeric_limits<Storage>::lowest());
+    }
+
+    static constexpr fixed max()
+    {
+        return from_raw(std::numeric_limits<Storage>::max());
+    }
+
+    /***************************************************************************
+     * @brief               The smallest positive value, one LSB.
+     **************************************************************************/
+    static constexpr fixed epsilon()
+    {
+        return from_raw(1);
+    }
+
+    friend constexpr fixed operator+(fixed a, fixed b)
+    {
+        return from_raw(m_saturate(static_cast<wide_t>(a.m_raw) + b.m_raw));
+    }
+
+    friend constexpr fixed operator-(fixed a, fixed b)
+    {
+        return from_raw(m_saturate(static_cast<wide_t>(a.m_raw) - b.m_raw));
+    }
+
+    friend constexpr fixed operator-(fixed a)
+    {
+        return from_raw(m_saturate(-static_cast<wide_t>(a.m_raw)));
+    }
+
+    friend constexpr fixed operator*(fixed a, fixed b)
+    {
+        const wide_t product{static_cast<wide_t>(a.m_raw) * b.m_raw};
+        return from_raw(m_saturate(m_shift_round(product)));
+    }
+
+    /***************************************************************************
+     * @brief               Division, saturated; a division by zero gives
+     *                      fixed::max or fixed::lowest by the sign of @p a.
+     **************************************************************************/
+    friend constexpr fixed operator/(fixed a, fixed b)
+    {
+        if (b.m_raw == 0) {
+            return (a.m_raw < 0) ? lowest() : max();
+        }
+        // rounded to nearest: half the divisor away from zero
+        const wide_t dividend{static_cast<wide_t>(a.m_raw) * m_one};
+        const wide_t half{((dividend < 0) != (b.m_raw < 0)) ? -(b.m_raw / 2) : b.m_raw / 2};
+        return from_raw(m_saturate((dividend + half) / b.m_raw));
+    }
+
+    constexpr fixed& operator+=(fixed b)
+    {
+        return *this = *this + b;
+    }
+    constexpr fixed& operator-=(fixed b)
+    {
+        return *this = *this - b;
+    }
+    constexpr fixed& operator*=(fixed b)
+    {
+        return *this = *this * b;
+    }
+    constexpr fixed& operator/=(fixed b)
+    {
+        return *this = *this / b;
+    }
+
+    friend constexpr bool operator==(fixed a, fixed b)
+    {
+        return a.m_raw == b.m_raw;
+    }
+    friend constexpr bool operator!=(fixed a, fixed b)
+    {
+        return a.m_raw != b.m_raw;
+    }
+    friend constexpr bool operator<(fixed a, fixed b)
+    {
+        return a.m_raw < b.m_raw;
+    }
+    friend constexpr bool operator<=(fixed a, fixed b)
+    {
+        return a.m_raw <= b.m_raw;
+    }
+    friend constexpr bool operator>(fixed a, fixed b)
+    {
+        return a.m_raw > b.m_raw;
+    }
+    friend constexpr bool operator>=(fixed a, fixed b)
+    {
+        return a.m_raw >= b.m_raw;
+    }
+
+  private:
+    static constexpr wide_t m_one{static_cast<wide_t>(1) << FractionalBits};
+
+    Storage m_raw{};
+
+    static constexpr Storage m_saturate(wide_t value)
+    {
+        if (value > std::numeric_limits<Storage>::max()) {
+            return std::numeric_limits<Storage>::max();
+        }
+        if (value < std::numeric_limits<Storage>::lowest()) {
+            return std::numeric_limits<Storage>::lowest();
+        }
+        return static_cast<Storage>(value);
+    }
+
+    // rounds half away from zero, shifting magnitudes only
+    static constexpr wide_t m_shift_round(wide_t value)
+    {
+        const wide_t half{static_cast<wide_t>(1) << (FractionalBits - 1)};
+        return (value >= 0) ? ((value + half) >> FractionalBits) : -((-value + half) >> FractionalBits);
+    }
+
+    template <typename V>
+    static constexpr Storage m_from(V value)
+    {
+        if constexpr (std::is_floating_point<V>::value) {
+            const double scaled{static_cast<double>(value) * static_cast<double>(m_one)};
+            if (!(scaled < static_cast<double>(std::numeric_limits<Storage>::max()))) {
+                return (scaled != scaled) ? Storage{} : std::numeric_limits<Storage>::max(); // NaN to zero
+            }
+            if (scaled <= static_cast<double>(std::numeric_limits<Storage>::lowest())) {
+                return std::numeric_limits<Storage>::lowest();
+            }
+            return static_cast<Storage>((scaled >= 0) ? static_cast<wide_t>(scaled + 0.5)
+                                                      : -static_cast<wide_t>(-scaled + 0.5));
+        } else {
+            // saturated before scaling, so any integer type fits the double width
+            constexpr std::intmax_t max_integer{std::numeric_limits<Storage>::max() >> FractionalBits};
+            constexpr std::intmax_t lowest_integer{std::numeric_limits<Storage>::lowest() >> FractionalBits};
+            if constexpr (std::is_signed<V>::value) {
+                if (static_cast<std::intmax_t>(value) > max_integer) {
+                    return std::numeric_limits<Storage>::max();
+                }
+                if (static_cast<std::intmax_t>(value) < lowest_integer) {
+                    return std::numeric_limits<Storage>::lowest();
+                }
+            } else {
+                if (static_cast<std::uintmax_t>(value) > static_cast<std::uintmax_t>(max_integer)) {
+                    return std::numeric_limits<Storage>::max();
+                }
+            }
+            return m_saturate(static_cast<wide_t>(value) * m_one);
+        }
+    }
+};
+
+/** Q15: 16 bit, in [-1, 1), e.g. ADC and DAC codes. */
+using q15 = fixed<15, std::int16_t>;
+/** Q31: 32 bit, in [-1, 1). */
+using q31 = fixed<31, std::int32_t>;
+
+template <typename T>
+struct is_fixed : std::false_type
+{
+};
+template <int FractionalBits, typename Storage>
+struct is_fixed<fixed<FractionalBits, Storage>> : std::true_type
+{
+};
+
+} // namespace toptica::tsp::fixed_point
+
+namespace std {
+
+/*******************************************************************************
+ * @brief                   Limits of a fixed-point number, as used for the
+ *                          default limits of pid.
+ ******************************************************************************/
+template <int FractionalBits, typename Storage>
+class numeric_limits<toptica::tsp::fixed_point::fixed<FractionalBits, Storage>>
+{
+    using fixed_t = toptica::tsp::fixed_point::fixed<FractionalBits, Storage>;
+
+  public:
+    static constexpr bool is_specialized{true};
+    static constexpr bool is_signed{true};
+    static constexpr bool is_integer{false};
+    static constexpr bool is_exact{true};
+
+    static constexpr fixed_t lowest()
+    {
+        return fixed_t::lowest();
+    }
+    static constexpr fixed_t min()
+    {
+        return fixed_t::epsilon();
+    }
+    static constexpr fixed_t max()
+    {
+        return fixed_t::max();
+    }
+    static constexpr fixed_t epsilon()
+    {
+        return fixed_t::epsilon();
+    }
+};
+
+} // namespace std
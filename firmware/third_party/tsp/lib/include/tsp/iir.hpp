@@ -26,6 +26,7 @@
 #include <array>
 #include <cmath>
 #include <complex>
+#include <cstddef>
 #include <tuple>
 #include <vector>
 
@@ -283,4 +284,250 @@ constexpr void iir<T, Vector, Allocator>::m_butterworth(
     m_data = data;
 }
 
+/*******************************************************************************
+ * @brief                   Coefficients of a fixed-order filter.
+ ******************************************************************************/
+template<
+    typename T,
+    std::size_t Order>
+struct coefficients {
+    std::array<T, Order + 1> a{};                     // denominator, a[0] = 1
+    std::array<T, Order + 1> b{};                     // numerator
+};
+
+namespace detail {
+
+constexpr double pi{3.14159265358979323846};
+
+/*******************************************************************************
+ * @brief                   Sine for 0 <= x <= pi/2 from its Taylor series,
+ *                          usable in constant expressions.
+ ******************************************************************************/
+constexpr double sin(const double x) {
+    double _term{x};
+    double _sum{0.0};
+    for (int _n = 1; _n < 40; _n += 2) {
+        _sum += _term;
+        _term *= -x * x / static_cast<double>((_n + 1) * (_n + 2));
+    }
+    return _sum;
+}
+
+/*******************************************************************************
+ * @brief                   Multiplies the polynomial in z^-1 by
+ *                          (1 + c1 z^-1 + c2 z^-2), in place.
+ ******************************************************************************/
+template<std::size_t Size>
+constexpr void multiply(
+        std::array<double, Size>& polynomial,
+        const double c1,
+        const double c2) {
+    for (std::size_t _i = Size - 1; _i > 0; --_i) {
+        polynomial[_i] += c1 * polynomial[_i - 1];
+        if (_i > 1) {
+            polynomial[_i] += c2 * polynomial[_i - 2];
+        }
+    }
+}
+
+}  // namespace detail
+
+/*******************************************************************************
+ * @brief                   Design Butterworth-filter of fixed order, without
+ *                          heap and usable in constant expressions.
+ *
+ * Same filter as iir::design() with characteristic::butterworth: the
+ * pre-warped analog prototype is mapped by the bilinear transform, pole pair
+ * by pole pair in real arithmetic.  The gain is unity at DC (low-pass) or at
+ * the Nyquist frequency (high-pass).
+ *
+ * @param frequency         The corner frequency of the filter, relative to the
+ *                          sampling frequency, 0 < frequency < 0.5.
+ * @param type              The type of the filter (low-pass, high-pass).
+ * @return                  The a- (denominator) and b-coefficients
+ *                          (numerator).
+ ******************************************************************************/
+template<
+    typename T,
+    std::size_t Order>
+constexpr coefficients<T, Order> butterworth(
+        const T frequency,
+        const filter::type type) {
+    static_assert(Order > 0, "Filter order must be at least one!");
+
+    // Pre-warp frequency: w = 2 tan(pi f), the cosine as sine of the
+    // complement stays accurate close to the Nyquist frequency
+    const double _angle{detail::pi * static_cast<double>(frequency)};
+    const double _w{2.0 * detail::sin(_angle) /
+        detail::sin(detail::pi / 2.0 - _angle)};
+
+    std::array<double, Order + 1> _a{1.0};
+    std::array<double, Order + 1> _b{1.0};
+
+    // Prototype pole w (c + js), c = cos(pi (2k + N + 1) / 2N) < 0, maps to
+    // z = (2 + p) / (2 - p): 1 - 2 Re(z) z^-1 + |z|^2 z^-2 per pole pair
+    for (std::size_t _k = 0; _k < Order / 2; ++_k) {
+        const double _c{-detail::sin(detail::pi *
+            static_cast<double>(2 * _k + 1) / static_cast<double>(2 * Order))};
+        const double _den{4.0 - 4.0 * _w * _c + _w * _w};
+        detail::multiply(
+            _a,
+            -2.0 * (4.0 - _w * _w) / _den,
+            (4.0 + 4.0 * _w * _c + _w * _w) / _den);
+    }
+    // Real pole p = -w of odd orders
+    if ((Order % 2) != 0) {
+        detail::multiply(
+            _a,
+            -(2.0 - _w) / (2.0 + _w),
+            0.0);
+    }
+
+    // All zeros at z = -1 (low-pass) or z = 1 (high-pass)
+    const double _zero{(type == filter::type::low_pass) ? 1.0 : -1.0};
+    for (std::size_t _i = 0; _i < Order; ++_i) {
+        detail::multiply(
+            _b,
+            _zero,
+            0.0);
+    }
+
+    // Normalize the gain at z = 1 (low-pass) or z = -1 (high-pass)
+    double _sum_a{0.0};
+    double _sum_b{0.0};
+    double _sign{1.0};
+    for (std::size_t _i = 0; _i <= Order; ++_i) {
+        _sum_a += _sign * _a[_i];
+        _sum_b += _sign * _b[_i];
+        _sign *= _zero;
+    }
+
+    coefficients<T, Order> _coefficients{};
+    for (std::size_t _i = 0; _i <= Order; ++_i) {
+        _coefficients.a[_i] = static_cast<T>(_a[_i]);
+        _coefficients.b[_i] = static_cast<T>(_b[_i] * _sum_a / _sum_b);
+    }
+    return _coefficients;
+}
+
+/*******************************************************************************
+ * @brief                   Direct Form 2 IIR filter of fixed order with static
+ *                          storage.
+ *
+ * Computes the same as iir::filter() with the same coefficients, but keeps
+ * coefficients and state in arrays instead of vectors, so it needs no heap
+ * and can be copied.  With butterworth() the design can be done at compile
+ * time:
+ *
+ *     constexpr auto c{butterworth<float, 2>(0.01F, filter::type::low_pass)};
+ *     static_iir<float, 2> lowpass{c};
+ *
+ * @tparam T                Sample and coefficient type.
+ * @tparam Order            Order of the filter.
+ ******************************************************************************/
+template<
+    typename T,
+    std::size_t Order>
+class static_iir {
+  public:
+    constexpr static_iir() = default;
+    constexpr explicit static_iir(
+        const coefficients<T, Order>& coefficients);
+    constexpr explicit static_iir(
+        T frequency,
+        filter::type type);
+
+    T filter(T sample);
+    constexpr const coefficients<T, Order>& get_coefficients() const;
+    constexpr void set_coefficients(
+        const coefficients<T, Order>& coefficients);
+    void reset();
+
+  private:
+    coefficients<T, Order> m_coefficients{};
+    std::array<T, Order + 1> m_xy{};
+};
+
+/*******************************************************************************
+ * @brief                   Construct from coefficients.
+ * @param coefficients      The a- (denominator) and b-coefficients
+ *                          (numerator).
+ ******************************************************************************/
+template<
+    typename T,
+    std::size_t Order>
+constexpr static_iir<T, Order>::static_iir(
+        const coefficients<T, Order>& coefficients) :
+    m_coefficients{coefficients} {
+}
+
+/*******************************************************************************
+ * @brief                   Construct Butterworth-filter, see butterworth().
+ * @param frequency         The corner frequency of the filter.
+ * @param type              The type of the filter (low-pass, high-pass).
+ ******************************************************************************/
+template<
+    typename T,
+    std::size_t Order>
+constexpr static_iir<T, Order>::static_iir(
+        const T frequency,
+        const filter::type type) :
+    m_coefficients{butterworth<T, Order>(frequency, type)} {
+}
+
+/*******************************************************************************
+ * @param sample            The sample to process.
+ * @return                  The processed sample.
+ ******************************************************************************/
+template<
+    typename T,
+    std::size_t Order>
+T static_iir<T, Order>::filter(T sample) {
+    T _value{};
+
+    m_xy[0] = sample;
+
+    for (std::size_t _i = Order; _i > 0; --_i) {
+        _value += m_coefficients.b[_i] * m_xy[_i];
+        m_xy[0] -= m_coefficients.a[_i] * m_xy[_i];
+        m_xy[_i] = m_xy[_i - 1];
+    }
+    _value += m_coefficients.b[0] * m_xy[0];
+
+    return _value;
+}
+
+/*******************************************************************************
+ * @return                  The a- (denominator) and b-coefficients
+ *                          (numerator).
+ ******************************************************************************/
+template<
+    typename T,
+    std::size_t Order>
+constexpr const coefficients<T, Order>& static_iir<T, Order>::get_coefficients() const {
+    return m_coefficients;
+}
+
+/*******************************************************************************
+ * @param coefficients      The a- (denominator) and b-coefficients
+ *                          (numerator).  The filter state is kept.
+ ******************************************************************************/
+template<
+    typename T,
+    std::size_t Order>
+constexpr void static_iir<T, Order>::set_coefficients(
+        const coefficients<T, Order>& coefficients) {
+    m_coefficients = coefficients;
+}
+
+/*******************************************************************************
+ * @brief                   Clears the filter state.
+ ******************************************************************************/
+template<
+    typename T,
+    std::size_t Order>
+void static_iir<T, Order>::reset() {
+    m_xy.fill(T{});
+}
+
 }  // namespace toptica::tsp::iir
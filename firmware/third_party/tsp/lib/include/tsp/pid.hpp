@@ -18,9 +18,11 @@
 #pragma once
 
 #include <boost/sml.hpp>
+#include <tsp/fixed_point.hpp>
 
 #include <algorithm>
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <limits>
@@ -61,7 +63,8 @@ namespace anti_windup {
 template <typename T>
 class none
 {
-    static_assert(std::is_floating_point<T>::value, "Only floating-point types are supported!");
+    static_assert(std::is_floating_point<T>::value || fixed_point::is_fixed<T>::value,
+                  "Only floating-point and fixed-point types are supported!");
 
   public:
     explicit constexpr none();
@@ -85,6 +88,27 @@ class conditional_integration : public none<T>
 
 } // namespace anti_windup
 
+/*******************************************************************************
+ * @brief Type of the configuration of a pid<T>: sampling interval and
+ *        K<sub>P</sub>, K<sub>I</sub>, K<sub>D</sub> coefficients.
+ *
+ * @details
+ *     T itself for floating-point T.  For fixed-point T the configuration is
+ *     float: a sampling interval of microseconds is below the resolution of
+ *     most Q formats, so the discrete coefficients are computed in float and
+ *     only the result is converted to T.
+ ******************************************************************************/
+template <typename T>
+struct parameter
+{
+    using type = T;
+};
+template <int FractionalBits, typename Storage>
+struct parameter<fixed_point::fixed<FractionalBits, Storage>>
+{
+    using type = float;
+};
+
 /*******************************************************************************
  * @class pid
  *
@@ -94,6 +118,13 @@ class conditional_integration : public none<T>
  *     The integration part is calculated using trapezoidal discretization
  *     since this gives a flat phase response in the [bode diagram](@ref bode).
  *
+ *     T is a floating-point or a fixed_point::fixed type.  In fixed point
+ *     every multiply-accumulate of pid::run rounds and saturates, and the
+ *     integrator is exact and reproducible across platforms.  Choose a Q
+ *     format with enough integer bits for the coefficients and the control
+ *     variable: in formats without integer bits, like Q15 and Q31, a gain or
+ *     coefficient of 1 saturates to the largest value below 1.
+ *
  * @startuml "PID structure" width=5cm
  *     skinparam nodesep 80
  *
@@ -136,7 +167,12 @@ template <typename T, template <typename> typename AntiWindup = anti_windup::non
 class pid : private AntiWindup<T>
 {
   public:
-    explicit pid(const T& sampling_interval, const T& p = 0, const T& i = 0, const T& d = 0);
+    using parameter_t = typename parameter<T>::type;
+
+    explicit pid(const parameter_t& sampling_interval,
+                 const parameter_t& p = 0,
+                 const parameter_t& i = 0,
+                 const parameter_t& d = 0);
 
     T run(const T& error);
 
@@ -149,12 +185,12 @@ class pid : private AntiWindup<T>
 
     T                get_gain() const;
     void             set_gain(const T& value);
-    T                get_p() const;
-    void             set_p(const T& value);
-    T                get_i() const;
-    void             set_i(const T& value);
-    T                get_d() const;
-    void             set_d(const T& value);
+    parameter_t      get_p() const;
+    void             set_p(const parameter_t& value);
+    parameter_t      get_i() const;
+    void             set_i(const parameter_t& value);
+    parameter_t      get_d() const;
+    void             set_d(const parameter_t& value);
     T                get_error() const;
     T                get_control_variable_minimum() const;
     void             set_control_variable_minimum(const T& value);
@@ -162,18 +198,18 @@ class pid : private AntiWindup<T>
     void             set_control_variable_maximum(const T& value);
     std::tuple<T, T> get_control_variable_limits() const;
     void             set_control_variable_limits(const T& minimum, const T& maximum);
-    T                get_sampling_interval() const;
-    void             set_sampling_interval(const T& value);
+    parameter_t      get_sampling_interval() const;
+    void             set_sampling_interval(const parameter_t& value);
     bool             is_limited() const;
 
   private:
-    T    m_sampling_interval;
-    T    m_p;
-    T    m_i;
-    T    m_d;
-    T    m_gain{1};
-    T    m_error{};
-    bool m_hold{true};
+    parameter_t m_sampling_interval;
+    parameter_t m_p;
+    parameter_t m_i;
+    parameter_t m_d;
+    T           m_gain{1};
+    T           m_error{};
+    bool        m_hold{true};
     struct control_variable_t
     {
         T minimum{std::numeric_limits<T>::lowest()};
@@ -242,6 +278,95 @@ class pid : private AntiWindup<T>
     boost::sml::sm<transitions> m_sm;
 };
 
+/*******************************************************************************
+ * @class pid_bank
+ *
+ * @brief N PID loops of a common sampling interval, updated together.
+ *
+ * @details
+ *     Every loop behaves like a pid<T, AntiWindup>: same discretization,
+ *     states, control variable limits and anti-windup, and pid_bank::run
+ *     returns the values of N calls of pid::run.  Instead of N state
+ *     machines with double-buffered coefficients and delays, coefficients,
+ *     integrator state and limits are kept in struct-of-arrays layout and
+ *     the states as bitmasks: a loop is running if it is enabled and not
+ *     held.  pid_bank::run updates all loops in one pass over contiguous
+ *     arrays without branches, which the compiler can vectorize.
+ *
+ *     Unlike pid, the setters are not buffered against a concurrent
+ *     pid_bank::run: call them from the context of pid_bank::run.
+ *
+ * @tparam T                Floating-point type.
+ * @tparam N                Number of loops.
+ * @tparam AntiWindup       Anti-windup logic of all loops.
+ ******************************************************************************/
+template <typename T, std::size_t N, template <typename> typename AntiWindup = anti_windup::none>
+class pid_bank : private AntiWindup<T>
+{
+    static_assert(std::is_floating_point<T>::value, "Only floating-point types are supported!");
+    static_assert(N > 0, "A PID bank needs at least one loop!");
+
+  public:
+    using values_t = std::array<T, N>;
+
+    explicit pid_bank(const T& sampling_interval, const T& p = 0, const T& i = 0, const T& d = 0);
+
+    void run(const values_t& error, values_t& control_variable);
+
+    void enable(std::size_t loop);
+    void disable(std::size_t loop);
+    void hold(std::size_t loop);
+    void reset(std::size_t loop);
+
+    const char* get_state(std::size_t loop) const;
+
+    T                get_gain(std::size_t loop) const;
+    void             set_gain(std::size_t loop, const T& value);
+    T                get_p(std::size_t loop) const;
+    void             set_p(std::size_t loop, const T& value);
+    T                get_i(std::size_t loop) const;
+    void             set_i(std::size_t loop, const T& value);
+    T                get_d(std::size_t loop) const;
+    void             set_d(std::size_t loop, const T& value);
+    T                get_error(std::size_t loop) const;
+    std::tuple<T, T> get_control_variable_limits(std::size_t loop) const;
+    void             set_control_variable_limits(std::size_t loop, const T& minimum, const T& maximum);
+    T                get_sampling_interval() const;
+    void             set_sampling_interval(const T& value);
+    bool             is_limited(std::size_t loop) const;
+
+  private:
+    using mask_t = std::array<std::uint32_t, (N + 31) / 32>;
+
+    T        m_sampling_interval;
+    values_t m_p{};
+    values_t m_i{};
+    values_t m_d{};
+    values_t m_gain{};
+    values_t m_error{};
+    values_t m_minimum{};
+    values_t m_maximum{};
+    values_t m_value{};
+    // coefficients
+    values_t m_coefficient_p{};
+    values_t m_coefficient_i{};
+    values_t m_coefficient_d{};
+    // delays
+    values_t m_delay_i{};
+    values_t m_integrator{};
+    values_t m_delay_error{};
+    values_t m_s{};
+    // states: idle (not enabled), running, hold (enabled and held)
+    mask_t m_enabled{};
+    mask_t m_held{};
+
+    static bool m_test(const mask_t& mask, std::size_t loop);
+    static void m_assign(mask_t& mask, std::size_t loop, bool value);
+
+    void m_update_coefficient(std::size_t loop);
+    void m_reset(std::size_t loop);
+};
+
 /*******************************************************************************
  * @param sampling_interval The sampling interval (time between two samples)
  *                          in [s]. t<sub>Sample</sub> = 1/f<sub>Sample</sub>.
@@ -250,7 +375,10 @@ class pid : private AntiWindup<T>
  * @param d                 The K<sub>D</sub> coefficient.
  ******************************************************************************/
 template <typename T, template <typename> typename AntiWindup>
-pid<T, AntiWindup>::pid(const T& sampling_interval, const T& p, const T& i, const T& d)
+pid<T, AntiWindup>::pid(const parameter_t& sampling_interval,
+                        const parameter_t& p,
+                        const parameter_t& i,
+                        const parameter_t& d)
   : m_sampling_interval{sampling_interval}, m_p{p}, m_i{i}, m_d{d}, m_sm{(*this)}
 {
     m_update_coefficient();
@@ -373,7 +501,7 @@ void pid<T, AntiWindup>::set_gain(const T& value)
  * @return                  The K<sub>P</sub> coefficient.
  ******************************************************************************/
 template <typename T, template <typename> typename AntiWindup>
-T pid<T, AntiWindup>::get_p() const
+typename pid<T, AntiWindup>::parameter_t pid<T, AntiWindup>::get_p() const
 {
     return m_p;
 }
@@ -383,7 +511,7 @@ T pid<T, AntiWindup>::get_p() const
  * @param value             The K<sub>P</sub> coefficient.
  ******************************************************************************/
 template <typename T, template <typename> typename AntiWindup>
-void pid<T, AntiWindup>::set_p(const T& value)
+void pid<T, AntiWindup>::set_p(const parameter_t& value)
 {
     if (m_p != value) {
         m_p = value;
@@ -397,7 +525,7 @@ void pid<T, AntiWindup>::set_p(const T& value)
  * @return                  The K<sub>I</sub> coefficient.
  ******************************************************************************/
 template <typename T, template <typename> typename AntiWindup>
-T pid<T, AntiWindup>::get_i() const
+typename pid<T, AntiWindup>::parameter_t pid<T, AntiWindup>::get_i() const
 {
     return m_i;
 }
@@ -407,7 +535,7 @@ T pid<T, AntiWindup>::get_i() const
  * @param value             The K<sub>I</sub> coefficient.
  ******************************************************************************/
 template <typename T, template <typename> typename AntiWindup>
-void pid<T, AntiWindup>::set_i(const T& value)
+void pid<T, AntiWindup>::set_i(const parameter_t& value)
 {
     if (m_i != value) {
         m_i = value;
@@ -421,7 +549,7 @@ void pid<T, AntiWindup>::set_i(const T& value)
  * @return                  The K<sub>D</sub> coefficient.
  ******************************************************************************/
 template <typename T, template <typename> typename AntiWindup>
-T pid<T, AntiWindup>::get_d() const
+typename pid<T, AntiWindup>::parameter_t pid<T, AntiWindup>::get_d() const
 {
     return m_d;
 }
@@ -431,7 +559,7 @@ T pid<T, AntiWindup>::get_d() const
  * @param value             The K<sub>D</sub> coefficient.
  ******************************************************************************/
 template <typename T, template <typename> typename AntiWindup>
-void pid<T, AntiWindup>::set_d(const T& value)
+void pid<T, AntiWindup>::set_d(const parameter_t& value)
 {
     if (m_d != value) {
         m_d = value;
@@ -518,7 +646,7 @@ void pid<T, AntiWindup>::set_control_variable_limits(const T& minimum, const T&
  * @return                  The sampling interval.
  ******************************************************************************/
 template <typename T, template <typename> typename AntiWindup>
-T pid<T, AntiWindup>::get_sampling_interval() const
+typename pid<T, AntiWindup>::parameter_t pid<T, AntiWindup>::get_sampling_interval() const
 {
     return m_sampling_interval;
 }
@@ -528,7 +656,7 @@ T pid<T, AntiWindup>::get_sampling_interval() const
  * @param value             The sampling interval.
  ******************************************************************************/
 template <typename T, template <typename> typename AntiWindup>
-void pid<T, AntiWindup>::set_sampling_interval(const T& value)
+void pid<T, AntiWindup>::set_sampling_interval(const parameter_t& value)
 {
     if (m_sampling_interval != value) {
         m_sampling_interval = value;
@@ -570,6 +698,234 @@ void pid<T, AntiWindup>::m_reset()
     m_delay = delay;
 }
 
+/*******************************************************************************
+ * @param sampling_interval The sampling interval (time between two samples)
+ *                          in [s] of all loops.
+ * @param p                 The K<sub>P</sub> coefficient of all loops.
+ * @param i                 The K<sub>I</sub> coefficient of all loops.
+ * @param d                 The K<sub>D</sub> coefficient of all loops.
+ ******************************************************************************/
+template <typename T, std::size_t N, template <typename> typename AntiWindup>
+pid_bank<T, N, AntiWindup>::pid_bank(const T& sampling_interval, const T& p, const T& i, const T& d)
+  : m_sampling_interval{sampling_interval}
+{
+    m_p.fill(p);
+    m_i.fill(i);
+    m_d.fill(d);
+    m_gain.fill(1);
+    m_minimum.fill(std::numeric_limits<T>::lowest());
+    m_maximum.fill(std::numeric_limits<T>::max());
+    for (std::size_t loop = 0; loop < N; loop++) {
+        m_update_coefficient(loop);
+    }
+}
+
+/*******************************************************************************
+ * @brief                   Executes a single PID time step of all loops.
+ *
+ * @details                 Loops which are not running keep their state and
+ *                          return their last control variable, see pid::run.
+ *
+ * @param error             The error of every loop.
+ * @param control_variable  The control variable of every loop.
+ ******************************************************************************/
+template <typename T, std::size_t N, template <typename> typename AntiWindup>
+void pid_bank<T, N, AntiWindup>::run(const values_t& error, values_t& control_variable)
+{
+    for (std::size_t loop = 0; loop < N; loop++) {
+        const bool running{m_test(m_enabled, loop) && !m_test(m_held, loop)};
+        const T    e{error[loop]};
+        m_error[loop] = e;
+
+        // computed for every loop and selected, so the pass has no branches
+        const T integrator{AntiWindup<T>::m_get_integrator(
+            m_integrator[loop], m_coefficient_i[loop] * e + m_delay_i[loop] * m_delay_error[loop], m_s[loop])};
+        const T unlimited{m_gain[loop]
+                          * (m_coefficient_p[loop] * e + integrator + m_coefficient_d[loop] * (e - m_delay_error[loop]))};
+        const T value{std::clamp(unlimited, m_minimum[loop], m_maximum[loop])};
+
+        m_integrator[loop]     = running ? integrator : m_integrator[loop];
+        m_delay_i[loop]        = running ? m_coefficient_i[loop] : m_delay_i[loop];
+        m_delay_error[loop]    = running ? e : m_delay_error[loop];
+        m_s[loop]              = running ? value - unlimited : m_s[loop];
+        m_value[loop]          = running ? value : m_value[loop];
+        control_variable[loop] = m_value[loop];
+    }
+}
+
+/*******************************************************************************
+ * @brief                   Enables a loop, see pid::enable.
+ ******************************************************************************/
+template <typename T, std::size_t N, template <typename> typename AntiWindup>
+void pid_bank<T, N, AntiWindup>::enable(std::size_t loop)
+{
+    m_assign(m_enabled, loop, true);
+    m_assign(m_held, loop, false);
+}
+/*******************************************************************************
+ * @brief                   Disables a loop, see pid::disable.
+ ******************************************************************************/
+template <typename T, std::size_t N, template <typename> typename AntiWindup>
+void pid_bank<T, N, AntiWindup>::disable(std::size_t loop)
+{
+    if (m_test(m_enabled, loop)) {
+        m_assign(m_enabled, loop, false);
+        m_assign(m_held, loop, false);
+        m_reset(loop);
+    }
+}
+/*******************************************************************************
+ * @brief                   Holds a running loop, see pid::hold.
+ ******************************************************************************/
+template <typename T, std::size_t N, template <typename> typename AntiWindup>
+void pid_bank<T, N, AntiWindup>::hold(std::size_t loop)
+{
+    if (m_test(m_enabled, loop)) {
+        m_assign(m_held, loop, true);
+    }
+}
+/*******************************************************************************
+ * @brief                   Resets a running loop, see pid::reset.
+ ******************************************************************************/
+template <typename T, std::size_t N, template <typename> typename AntiWindup>
+void pid_bank<T, N, AntiWindup>::reset(std::size_t loop)
+{
+    if (m_test(m_enabled, loop) && !m_test(m_held, loop)) {
+        m_reset(loop);
+    }
+}
+
+/*******************************************************************************
+ * @brief                   Returns the state of a loop, named as by
+ *                          pid::get_state.
+ ******************************************************************************/
+template <typename T, std::size_t N, template <typename> typename AntiWindup>
+const char* pid_bank<T, N, AntiWindup>::get_state(std::size_t loop) const
+{
+    if (!m_test(m_enabled, loop)) {
+        return "idle";
+    }
+    return m_test(m_held, loop) ? "hold" : "running";
+}
+
+template <typename T, std::size_t N, template <typename> typename AntiWindup>
+T pid_bank<T, N, AntiWindup>::get_gain(std::size_t loop) const
+{
+    return m_gain[loop];
+}
+template <typename T, std::size_t N, template <typename> typename AntiWindup>
+void pid_bank<T, N, AntiWindup>::set_gain(std::size_t loop, const T& value)
+{
+    m_gain[loop] = value;
+}
+template <typename T, std::size_t N, template <typename> typename AntiWindup>
+T pid_bank<T, N, AntiWindup>::get_p(std::size_t loop) const
+{
+    return m_p[loop];
+}
+template <typename T, std::size_t N, template <typename> typename AntiWindup>
+void pid_bank<T, N, AntiWindup>::set_p(std::size_t loop, const T& value)
+{
+    if (m_p[loop] != value) {
+        m_p[loop] = value;
+        m_update_coefficient(loop);
+    }
+}
+template <typename T, std::size_t N, template <typename> typename AntiWindup>
+T pid_bank<T, N, AntiWindup>::get_i(std::size_t loop) const
+{
+    return m_i[loop];
+}
+template <typename T, std::size_t N, template <typename> typename AntiWindup>
+void pid_bank<T, N, AntiWindup>::set_i(std::size_t loop, const T& value)
+{
+    if (m_i[loop] != value) {
+        m_i[loop] = value;
+        m_update_coefficient(loop);
+    }
+}
+template <typename T, std::size_t N, template <typename> typename AntiWindup>
+T pid_bank<T, N, AntiWindup>::get_d(std::size_t loop) const
+{
+    return m_d[loop];
+}
+template <typename T, std::size_t N, template <typename> typename AntiWindup>
+void pid_bank<T, N, AntiWindup>::set_d(std::size_t loop, const T& value)
+{
+    if (m_d[loop] != value) {
+        m_d[loop] = value;
+        m_update_coefficient(loop);
+    }
+}
+template <typename T, std::size_t N, template <typename> typename AntiWindup>
+T pid_bank<T, N, AntiWindup>::get_error(std::size_t loop) const
+{
+    return m_error[loop];
+}
+template <typename T, std::size_t N, template <typename> typename AntiWindup>
+std::tuple<T, T> pid_bank<T, N, AntiWindup>::get_control_variable_limits(std::size_t loop) const
+{
+    return std::make_tuple(m_minimum[loop], m_maximum[loop]);
+}
+template <typename T, std::size_t N, template <typename> typename AntiWindup>
+void pid_bank<T, N, AntiWindup>::set_control_variable_limits(std::size_t loop, const T& minimum, const T& maximum)
+{
+    m_minimum[loop] = minimum;
+    m_maximum[loop] = maximum;
+}
+template <typename T, std::size_t N, template <typename> typename AntiWindup>
+T pid_bank<T, N, AntiWindup>::get_sampling_interval() const
+{
+    return m_sampling_interval;
+}
+/*******************************************************************************
+ * @brief                   Sets the sampling interval of all loops.
+ ******************************************************************************/
+template <typename T, std::size_t N, template <typename> typename AntiWindup>
+void pid_bank<T, N, AntiWindup>::set_sampling_interval(const T& value)
+{
+    if (m_sampling_interval != value) {
+        m_sampling_interval = value;
+        for (std::size_t loop = 0; loop < N; loop++) {
+            m_update_coefficient(loop);
+        }
+    }
+}
+template <typename T, std::size_t N, template <typename> typename AntiWindup>
+bool pid_bank<T, N, AntiWindup>::is_limited(std::size_t loop) const
+{
+    return m_s[loop] != 0;
+}
+
+template <typename T, std::size_t N, template <typename> typename AntiWindup>
+bool pid_bank<T, N, AntiWindup>::m_test(const mask_t& mask, std::size_t loop)
+{
+    return ((mask[loop / 32] >> (loop % 32)) & 1U) != 0;
+}
+
+template <typename T, std::size_t N, template <typename> typename AntiWindup>
+void pid_bank<T, N, AntiWindup>::m_assign(mask_t& mask, std::size_t loop, bool value)
+{
+    const std::uint32_t bit{1U << (loop % 32)};
+    mask[loop / 32] = value ? (mask[loop / 32] | bit) : (mask[loop / 32] & ~bit);
+}
+
+template <typename T, std::size_t N, template <typename> typename AntiWindup>
+void pid_bank<T, N, AntiWindup>::m_update_coefficient(std::size_t loop)
+{
+    m_coefficient_p[loop] = m_p[loop];
+    m_coefficient_i[loop] = m_i[loop] * m_sampling_interval / 2;
+    m_coefficient_d[loop] = m_d[loop] / m_sampling_interval;
+}
+
+template <typename T, std::size_t N, template <typename> typename AntiWindup>
+void pid_bank<T, N, AntiWindup>::m_reset(std::size_t loop)
+{
+    m_integrator[loop]  = 0;
+    m_delay_error[loop] = 0;
+    m_s[loop]           = 0;
+}
+
 template <typename T>
 constexpr anti_windup::none<T>::none() = default;
 
@@ -591,8 +947,16 @@ T anti_windup::conditional_integration<T>::m_get_integrator(
 {
     auto value{integrator};
 
-    // anti-windup for integrator part: conditional integrator
-    if ((s == 0) || ((integrator * integrator_increment) <= 0)) {
+    // anti-windup for integrator part: conditional integrator, integrating
+    // unless the integrator and the increment have the same sign
+    bool opposite{};
+    if constexpr (fixed_point::is_fixed<T>::value) {
+        // the rounded fixed-point product of a small increment is zero
+        opposite = (integrator <= 0 && integrator_increment >= 0) || (integrator >= 0 && integrator_increment <= 0);
+    } else {
+        opposite = (integrator * integrator_increment) <= 0;
+    }
+    if ((s == 0) || opposite) {
         value += integrator_increment;
     }
 
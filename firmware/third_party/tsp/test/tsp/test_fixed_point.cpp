@@ -0,0 +1,115 @@
+/*******************************************************************************
+ *
+ * @copyright   TOPTICA Photonics AG
+ * @date        2026
+ *
+ * @file        test_fixed_point.cpp
+ * @brief       Unit Tests for the fixed-point numbers.
+ *
+ * @author      agent <agent@local>
+ *
+ ******************************************************************************/
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <limits>
+
+#include <tsp/fixed_point.hpp>
+
+using namespace toptica::tsp::fixed_point;
+
+BOOST_AUTO_TEST_SUITE(fixed_point)
+
+    BOOST_AUTO_TEST_CASE(fixed_point_conversion) {
+        BOOST_TEST_MESSAGE("fixed_point: Conversion, rounded and saturated");
+
+        BOOST_TEST(q15{0.5}.raw() == 16384);
+        BOOST_TEST(q15{-1}.raw() == -32768);
+        BOOST_TEST(q15{1}.raw() == 32767);
+        BOOST_TEST(q15{1.5F}.raw() == 32767);
+        BOOST_TEST(q15{-2.0}.raw() == -32768);
+        BOOST_TEST(q15{std::numeric_limits<double>::quiet_NaN()}.raw() == 0);
+        BOOST_TEST(q15{std::numeric_limits<float>::infinity()}.raw() == 32767);
+
+        // to nearest, half away from zero
+        BOOST_TEST(q15{1.5 / 32768}.raw() == 2);
+        BOOST_TEST(q15{-1.5 / 32768}.raw() == -2);
+        BOOST_TEST(q15{1.4 / 32768}.raw() == 1);
+
+        // integers saturate before scaling
+        BOOST_TEST(fixed<24>{100}.raw() == 100 << 24);
+        BOOST_TEST(fixed<24>{1000}.raw() == std::numeric_limits<std::int32_t>::max());
+        BOOST_TEST(fixed<24>{-1000}.raw() == std::numeric_limits<std::int32_t>::lowest());
+        BOOST_TEST(fixed<24>{std::numeric_limits<std::int64_t>::lowest()}.raw()
+                   == std::numeric_limits<std::int32_t>::lowest());
+        BOOST_TEST(fixed<24>{std::numeric_limits<std::uint64_t>::max()}.raw()
+                   == std::numeric_limits<std::int32_t>::max());
+
+        BOOST_TEST(q31::from_raw(-7).raw() == -7);
+        BOOST_TEST(static_cast<double>(q31{0.25}) == 0.25);
+        BOOST_TEST(static_cast<float>(fixed<24>{-3.5}) == -3.5F);
+        BOOST_TEST(static_cast<double>(q15::epsilon()) == 1.0 / 32768);
+        BOOST_TEST(static_cast<double>(q15::lowest()) == -1.0);
+        BOOST_TEST((std::numeric_limits<q31>::max() == q31::max()));
+        BOOST_TEST((std::numeric_limits<q31>::lowest() == q31::lowest()));
+    }
+
+    BOOST_AUTO_TEST_CASE(fixed_point_saturation) {
+        BOOST_TEST_MESSAGE("fixed_point: Sums, differences and products saturate instead of wrapping around");
+
+        BOOST_TEST((q15{0.75} + q15{0.5} == q15::max()));
+        BOOST_TEST((q15{-0.75} - q15{0.5} == q15::lowest()));
+        BOOST_TEST((-q15::lowest() == q15::max()));
+        BOOST_TEST((q31::lowest() * q31::lowest() == q31::max()));
+        BOOST_TEST((fixed<24>{100} * fixed<24>{2} == fixed<24>::max()));
+        BOOST_TEST((fixed<24>{-100} * fixed<24>{2} == fixed<24>::lowest()));
+
+        q15 sum{0.5};
+        sum += q15{0.25};
+        BOOST_TEST((sum == q15{0.75}));
+        sum += q15{0.5};
+        BOOST_TEST((sum == q15::max()));
+        // 1 is q15::max as well
+        sum -= q15{1};
+        BOOST_TEST((sum == 0));
+    }
+
+    BOOST_AUTO_TEST_CASE(fixed_point_rounding) {
+        BOOST_TEST_MESSAGE("fixed_point: Products and quotients round to nearest, symmetric around zero");
+
+        const q15 lsb{q15::epsilon()};
+        const q15 half{0.5};
+        // 0.5 LSB rounds away from zero
+        BOOST_TEST((lsb * half).raw() == 1);
+        BOOST_TEST((-lsb * half).raw() == -1);
+        // 0.25 LSB rounds to zero
+        BOOST_TEST((lsb * q15{0.25}).raw() == 0);
+        BOOST_TEST((-lsb * q15{0.25}).raw() == 0);
+
+        BOOST_TEST((fixed<24>{3} * fixed<24>{-2.5} == fixed<24>{-7.5}));
+        BOOST_TEST((fixed<24>{1} / fixed<24>{3} == fixed<24>{1.0 / 3}));
+        BOOST_TEST((fixed<24>{-2} / fixed<24>{3} == fixed<24>{-2.0 / 3}));
+        BOOST_TEST((fixed<24>{2} / fixed<24>{-3} == fixed<24>{-2.0 / 3}));
+        BOOST_TEST((q15{0.25} / q15{0.5} == half));
+        BOOST_TEST((q15{0.5} / q15{0.25} == q15::max()));
+
+        // a division by zero saturates by the sign of the dividend
+        BOOST_TEST((q31{0.5} / q31{0} == q31::max()));
+        BOOST_TEST((q31{-0.5} / q31{0} == q31::lowest()));
+        BOOST_TEST((q31{0} / q31{0} == q31::max()));
+    }
+
+    BOOST_AUTO_TEST_CASE(fixed_point_comparison) {
+        BOOST_TEST_MESSAGE("fixed_point: Comparisons, also against converted numbers");
+
+        BOOST_TEST((q15{0.25} < q15{0.5}));
+        BOOST_TEST((q15{0.5} > 0));
+        BOOST_TEST((q15{-0.5} <= 0));
+        BOOST_TEST((q15{0} >= 0));
+        BOOST_TEST((q15{0} == 0));
+        BOOST_TEST((q15{0.25} != q15{0.5}));
+        BOOST_TEST(is_fixed<q31>::value);
+        BOOST_TEST(!is_fixed<float>::value);
+    }
+
+BOOST_AUTO_TEST_SUITE_END()
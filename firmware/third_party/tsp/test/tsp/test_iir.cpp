@@ -357,4 +357,85 @@ BOOST_AUTO_TEST_SUITE(iir)
         }
     }
 
+    BOOST_AUTO_TEST_CASE(static_iir_butterworth_matches_iir, * boost::unit_test::tolerance(1e-5F)) {
+        BOOST_TEST_MESSAGE("static_iir: Butterworth coefficients match iir::design()");
+
+        for (const auto type : {toptica::tsp::filter::type::low_pass,
+                                toptica::tsp::filter::type::high_pass}) {
+            for (const auto frequency : {1.0F/500.0F, 1.0F/20.0F, 249.0F/500.0F}) {
+                toptica::tsp::iir::iir<float> iir2{
+                    frequency,
+                    type,
+                    2,
+                    toptica::tsp::iir::characteristic::butterworth};
+                toptica::tsp::iir::iir<float> iir3{
+                    frequency,
+                    type,
+                    3,
+                    toptica::tsp::iir::characteristic::butterworth};
+                const auto c2 = toptica::tsp::iir::butterworth<float, 2>(frequency, type);
+                const auto c3 = toptica::tsp::iir::butterworth<float, 3>(frequency, type);
+
+                auto [a2, b2] = iir2.get_coefficients();
+                auto [a3, b3] = iir3.get_coefficients();
+                BOOST_TEST(c2.a == a2, boost::test_tools::per_element());
+                BOOST_TEST(c2.b == b2, boost::test_tools::per_element());
+                BOOST_TEST(c3.a == a3, boost::test_tools::per_element());
+                BOOST_TEST(c3.b == b3, boost::test_tools::per_element());
+            }
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(static_iir_butterworth_compile_time) {
+        BOOST_TEST_MESSAGE("static_iir: Butterworth design in a constant expression");
+
+        constexpr auto c = toptica::tsp::iir::butterworth<float, 2>(
+            1.0F/500.0F,
+            toptica::tsp::filter::type::low_pass);
+        static_assert(c.a[0] == 1.0F);
+        static_assert(c.b[0] == c.b[2]);
+
+        constexpr toptica::tsp::iir::static_iir<float, 2> iir{c};
+        BOOST_TEST_CHECK(iir.get_coefficients().a == c.a);
+        BOOST_TEST_CHECK(iir.get_coefficients().b == c.b);
+    }
+
+    BOOST_AUTO_TEST_CASE(static_iir_equals_iir) {
+        BOOST_TEST_MESSAGE("static_iir: Same output as iir with the same coefficients");
+
+        toptica::tsp::iir::static_iir<float, 3> iir{
+            1.0F/50.0F,
+            toptica::tsp::filter::type::low_pass};
+        const auto& c = iir.get_coefficients();
+        toptica::tsp::iir::iir<float> reference{
+            std::vector<float>(c.a.begin(), c.a.end()),
+            std::vector<float>(c.b.begin(), c.b.end())};
+
+        // step, then a square wave
+        for (std::size_t n = 0; n < 1000; ++n) {
+            const float x = ((n / 100) % 2 == 0) ? 1.0F : -0.5F;
+            const float y = iir.filter(x);
+            BOOST_TEST_CHECK(y == reference.filter(x));
+        }
+
+        iir.reset();
+        BOOST_TEST_CHECK(iir.filter(0.0F) == 0.0F);
+    }
+
+    BOOST_AUTO_TEST_CASE(static_iir_butterworth_2_order_low_pass_1_500_impulse_response, * boost::unit_test::tolerance(1e-3F)) {
+        BOOST_TEST_MESSAGE("static_iir: impulse response for "
+            "2. Order Butterworth low pass filter with fc=1/500fs");
+
+        float x{1.0F};
+
+        toptica::tsp::iir::static_iir<float, 2> iir{
+            1.0F/500.0F,
+            toptica::tsp::filter::type::low_pass};
+
+        for (auto& y : toptica::test::data::butterworth_2_order_low_pass_1_500_impulse_response) {
+            BOOST_TEST(y == iir.filter(x));
+            x = 0.0F;
+        }
+    }
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -23,10 +23,20 @@
 
 #include <test_data.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
 
 
 using namespace toptica::tsp::pid;
+using toptica::tsp::fixed_point::fixed;
+using toptica::tsp::fixed_point::q15;
+using toptica::tsp::fixed_point::q31;
 using boost::unit_test::tolerance;
 using boost::test_tools::fpc::percent_tolerance;
 
@@ -904,4 +914,231 @@ BOOST_AUTO_TEST_SUITE(PID)
             BOOST_TEST(output == output_reference);
         }
     }
+    // N scalar loops as reference, driven by the same random sequence of
+    // errors, state changes, retuning and limits as the bank
+    template <template <typename> typename AntiWindup>
+    void check_pid_bank_equals_pids()
+    {
+        constexpr std::size_t N{37}; // more than one mask word
+        const float           sampling_interval{0.001F};
+
+        pid_bank<float, N, AntiWindup>                        bank{sampling_interval, 1.0F, 10.0F};
+        std::vector<std::unique_ptr<pid<float, AntiWindup>>> pids;
+        for (std::size_t k = 0; k < N; k++) {
+            pids.push_back(std::make_unique<pid<float, AntiWindup>>(sampling_interval, 1.0F, 10.0F));
+        }
+
+        std::mt19937                          rng{29};
+        std::uniform_real_distribution<float> value{-1.0F, 1.0F};
+        std::uniform_int_distribution<int>    action{0, 99};
+        std::uniform_int_distribution<int>    loops{0, N - 1};
+
+        for (std::size_t k = 0; k < N; k++) {
+            if (k % 5 != 0) {
+                bank.enable(k);
+                pids[k]->enable();
+            }
+            if (k % 3 == 0) {
+                bank.set_control_variable_limits(k, -0.5F, 0.5F);
+                pids[k]->set_control_variable_limits(-0.5F, 0.5F);
+            }
+        }
+
+        for (int n = 0; n < 20000; n++) {
+            const auto k{static_cast<std::size_t>(loops(rng))};
+            switch (action(rng)) {
+            case 0:
+                bank.enable(k);
+                pids[k]->enable();
+                break;
+            case 1:
+                bank.disable(k);
+                pids[k]->disable();
+                break;
+            case 2:
+                bank.hold(k);
+                pids[k]->hold();
+                break;
+            case 3:
+                bank.reset(k);
+                pids[k]->reset();
+                break;
+            case 4: {
+                const float p{10.0F * value(rng)};
+                const float i{100.0F * value(rng)};
+                const float d{1e-3F * value(rng)};
+                bank.set_p(k, p);
+                bank.set_i(k, i);
+                bank.set_d(k, d);
+                pids[k]->set_p(p);
+                pids[k]->set_i(i);
+                pids[k]->set_d(d);
+                break;
+            }
+            case 5: {
+                const float gain{2.0F * value(rng)};
+                bank.set_gain(k, gain);
+                pids[k]->set_gain(gain);
+                break;
+            }
+            default:
+                break;
+            }
+
+            std::array<float, N> error{};
+            std::array<float, N> control_variable{};
+            for (auto& e : error) {
+                e = value(rng);
+            }
+            bank.run(error, control_variable);
+            for (std::size_t loop = 0; loop < N; loop++) {
+                BOOST_TEST_REQUIRE(control_variable[loop] == pids[loop]->run(error[loop]));
+                BOOST_TEST_REQUIRE(bank.is_limited(loop) == pids[loop]->is_limited());
+                BOOST_TEST_REQUIRE(std::string{bank.get_state(loop)} == pids[loop]->get_state());
+            }
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(pid_bank_states) {
+        BOOST_TEST_MESSAGE("PID bank: Check state transitions of a single loop");
+
+        pid_bank<float, 2> bank{1};
+
+        BOOST_CHECK_EQUAL(bank.get_state(0), "idle");
+        bank.hold(0);
+        BOOST_CHECK_EQUAL(bank.get_state(0), "idle");
+        bank.enable(0);
+        BOOST_CHECK_EQUAL(bank.get_state(0), "running");
+        BOOST_CHECK_EQUAL(bank.get_state(1), "idle");
+        bank.hold(0);
+        BOOST_CHECK_EQUAL(bank.get_state(0), "hold");
+        bank.reset(0);
+        BOOST_CHECK_EQUAL(bank.get_state(0), "hold");
+        bank.enable(0);
+        BOOST_CHECK_EQUAL(bank.get_state(0), "running");
+        bank.disable(0);
+        BOOST_CHECK_EQUAL(bank.get_state(0), "idle");
+        BOOST_CHECK_EQUAL(bank.get_gain(0), 1);
+        BOOST_CHECK_EQUAL(bank.get_sampling_interval(), 1);
+    }
+
+    BOOST_AUTO_TEST_CASE(pid_bank_equals_pids) {
+        BOOST_TEST_MESSAGE("PID bank: Every loop returns the values of a separate PID loop");
+
+        check_pid_bank_equals_pids<anti_windup::none>();
+    }
+
+    BOOST_AUTO_TEST_CASE(pid_bank_equals_pids_conditional_integration) {
+        BOOST_TEST_MESSAGE("PID bank: Every loop equals a separate PID loop with conditional integration");
+
+        check_pid_bank_equals_pids<anti_windup::conditional_integration>();
+    }
+
+    // closed loop of a fixed-point PID loop and the plant of pid_closed_loop,
+    // returning the largest deviation from the float loop
+    template <typename T, template <typename> typename AntiWindup = anti_windup::none>
+    double fixed_closed_loop_deviation(float p, float i, float d, float limit, double setpoint)
+    {
+        toptica::tsp::iir::iir<double> float_plant{};
+        toptica::tsp::iir::iir<double> fixed_plant{};
+        {
+            auto [a, b] = toptica::plant<double, double>(
+                0.001,
+                10.0,
+                0.1);
+            float_plant.set_coefficients(a, b);
+            fixed_plant.set_coefficients(a, b);
+        }
+
+        pid<float, AntiWindup> float_pid{0.001F, p, i, d};
+        pid<T, AntiWindup>     fixed_pid{0.001F, p, i, d};
+        float_pid.set_control_variable_limits(-limit, limit);
+        fixed_pid.set_control_variable_limits(T{-limit}, T{limit});
+        float_pid.enable();
+        fixed_pid.enable();
+
+        double float_output{};
+        double fixed_output{};
+        double deviation{};
+        for (int n = 0; n < 3000; n++) {
+            float_output = float_plant.filter(static_cast<double>(
+                    float_pid.run(static_cast<float>(setpoint - float_output))));
+            fixed_output = fixed_plant.filter(static_cast<double>(
+                    fixed_pid.run(T{setpoint - fixed_output})));
+            deviation = std::max(deviation, std::fabs(fixed_output - float_output));
+        }
+        return deviation;
+    }
+
+    BOOST_AUTO_TEST_CASE(pid_fixed_point_coefficients) {
+        BOOST_TEST_MESSAGE("PID: Fixed-point loop takes a float configuration");
+
+        pid<q31> pid{0.001F, 0.5F, 100.0F, 1e-4F};
+
+        BOOST_TEST(pid.get_sampling_interval() == 0.001F);
+        BOOST_TEST(pid.get_p() == 0.5F);
+        BOOST_TEST(pid.get_i() == 100.0F);
+        BOOST_TEST(pid.get_d() == 1e-4F);
+        BOOST_TEST((pid.get_control_variable_minimum() == q31::lowest()));
+        BOOST_TEST((pid.get_control_variable_maximum() == q31::max()));
+
+        // P only: the output is the rounded product
+        pid.set_i(0);
+        pid.set_d(0);
+        pid.enable();
+        BOOST_TEST((pid.run(q31{0.5}) == q31{0.25}));
+        BOOST_TEST((pid.run(q31::lowest()) == q31{-0.5}));
+    }
+
+    BOOST_AUTO_TEST_CASE(pid_fixed_point_saturation) {
+        BOOST_TEST_MESSAGE("PID: Fixed-point loop saturates instead of wrapping around");
+
+        pid<q15> pid{0.001F, 0.9F, 1000.0F};
+        pid.enable();
+
+        // the integrator runs into full scale and stays there
+        q15 control_variable{};
+        for (int n = 0; n < 1000; n++) {
+            control_variable = pid.run(q15::max());
+            BOOST_TEST_REQUIRE((control_variable >= 0));
+        }
+        // the gain of 1 is q15::max as well
+        BOOST_TEST((control_variable >= q15::max() - q15::epsilon()));
+        for (int n = 0; n < 1000; n++) {
+            control_variable = pid.run(q15::lowest());
+            BOOST_TEST_REQUIRE((control_variable <= q15{0.9}));
+        }
+        BOOST_TEST((control_variable <= q15::lowest() + q15::epsilon()));
+    }
+
+    BOOST_AUTO_TEST_CASE(pid_fixed_point_closed_loop) {
+        BOOST_TEST_MESSAGE("PID: Fixed-point closed loop step response follows the float loop");
+
+        // Q15.16: range of the derivative coefficient d / sampling interval
+        const double q16_deviation{fixed_closed_loop_deviation<fixed<16>>(14.6F, 6.0F, 1.02F, 2000.0F, 1.0)};
+        BOOST_TEST_MESSAGE("Q15.16 deviation: " << q16_deviation);
+        BOOST_TEST(q16_deviation < 1e-3);
+
+        const double q24_deviation{fixed_closed_loop_deviation<fixed<24>>(14.6F, 6.0F, 0.01F, 100.0F, 1.0)};
+        BOOST_TEST_MESSAGE("Q7.24 deviation: " << q24_deviation);
+        BOOST_TEST(q24_deviation < 1e-5);
+
+        const double q31_deviation{fixed_closed_loop_deviation<q31>(0.2F, 2.0F, 0.0F, 0.9F, 0.25)};
+        BOOST_TEST_MESSAGE("Q31 deviation: " << q31_deviation);
+        BOOST_TEST(q31_deviation < 1e-6);
+    }
+
+    BOOST_AUTO_TEST_CASE(pid_fixed_point_conditional_integration) {
+        BOOST_TEST_MESSAGE("PID: Fixed-point closed loop with limits and conditional integration");
+
+        const double q24_deviation{fixed_closed_loop_deviation<fixed<24>, anti_windup::conditional_integration>(
+                14.6F, 6.0F, 0.01F, 2.0F, 1.0)};
+        BOOST_TEST_MESSAGE("Q7.24 deviation: " << q24_deviation);
+        BOOST_TEST(q24_deviation < 1e-5);
+
+        const double q31_deviation{fixed_closed_loop_deviation<q31, anti_windup::conditional_integration>(
+                0.2F, 2.0F, 0.0F, 0.05F, 0.25)};
+        BOOST_TEST_MESSAGE("Q31 deviation: " << q31_deviation);
+        BOOST_TEST(q31_deviation < 1e-6);
+    }
 BOOST_AUTO_TEST_SUITE_END()